@@ -0,0 +1 @@
+#include "../../../../src/compilertrace.h"
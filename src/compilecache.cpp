@@ -0,0 +1,166 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "compilecache_p.h"
+#include "live/mlnodetojson.h"
+#include "live/path.h"
+#include "live/exception.h"
+
+#include <stdint.h>
+
+namespace lv{ namespace el{
+
+MLNode CompileCache::Entry::toMLNode() const{
+    MLNode result(MLNode::Object);
+    result["config"] = configHash;
+    result["content"] = contentHash;
+    result["resolution"] = resolutionHash;
+
+    MLNode exportsNode(MLNode::Array);
+    for ( const Export& e : exports ){
+        MLNode n(MLNode::Object);
+        n["name"] = e.name;
+        n["component"] = e.isComponent;
+        exportsNode.append(n);
+    }
+    result["exports"] = exportsNode;
+
+    MLNode importsNode(MLNode::Array);
+    for ( const Import& i : imports ){
+        MLNode n(MLNode::Object);
+        n["uri"] = i.uri;
+        n["as"] = i.as;
+        n["relative"] = i.isRelative;
+        importsNode.append(n);
+    }
+    result["imports"] = importsNode;
+
+    MLNode importTypesNode(MLNode::Array);
+    for ( const ImportType& it : importTypes ){
+        MLNode n(MLNode::Object);
+        n["namespace"] = it.importNamespace;
+        n["name"] = it.name;
+        importTypesNode.append(n);
+    }
+    result["importTypes"] = importTypesNode;
+
+    result["output"] = output;
+    return result;
+}
+
+void CompileCache::Entry::fromMLNode(const MLNode &node){
+    configHash = node["config"].asString();
+    contentHash = node["content"].asString();
+    resolutionHash = node["resolution"].asString();
+
+    exports.clear();
+    for ( const MLNode& n : node["exports"].asArray() ){
+        Export e;
+        e.name = n["name"].asString();
+        e.isComponent = n["component"].asBool();
+        exports.push_back(e);
+    }
+
+    imports.clear();
+    for ( const MLNode& n : node["imports"].asArray() ){
+        Import i;
+        i.uri = n["uri"].asString();
+        i.as = n["as"].asString();
+        i.isRelative = n["relative"].asBool();
+        imports.push_back(i);
+    }
+
+    importTypes.clear();
+    for ( const MLNode& n : node["importTypes"].asArray() ){
+        ImportType it;
+        it.importNamespace = n["namespace"].asString();
+        it.name = n["name"].asString();
+        importTypes.push_back(it);
+    }
+
+    output = node["output"].asString();
+}
+
+CompileCache::CompileCache(const std::string &path, FileIOInterface *fileIO)
+    : m_path(path)
+    , m_fileIO(fileIO)
+    , m_pathCreated(false)
+    , m_totalHits(0)
+    , m_totalMisses(0)
+{
+}
+
+/**
+ * \brief Reads the entry of \p filePath, returns false if there is none or if it was stored
+ * for a different content or configuration
+ */
+bool CompileCache::find(const std::string &filePath, const std::string &configHash, const std::string &contentHash, Entry &entry){
+    std::string path = entryPath(filePath);
+    if ( !Path::exists(path) )
+        return false;
+
+    try{
+        MLNode node;
+        ml::fromJson(m_fileIO->readFromFile(path), node);
+        if ( node["content"].asString() != contentHash || node["config"].asString() != configHash )
+            return false;
+        entry.fromMLNode(node);
+    } catch ( lv::Exception& ){
+        // unreadable entries are treated as missing, and get replaced on the next store
+        return false;
+    }
+    return true;
+}
+
+void CompileCache::store(const std::string &filePath, const Entry &entry){
+    {
+        std::lock_guard<std::mutex> guard(m_pathMutex);
+        if ( !m_pathCreated ){
+            if ( !Path::exists(m_path) )
+                Path::createDirectories(m_path);
+            m_pathCreated = true;
+        }
+    }
+
+    std::string data;
+    ml::toJson(entry.toMLNode(), data);
+    m_fileIO->writeToFile(entryPath(filePath), data);
+}
+
+/**
+ * \brief 64 bit FNV-1a hash of \p data, as hex
+ */
+std::string CompileCache::hash(const std::string &data){
+    uint64_t h = 14695981039346656037ULL;
+    for ( char c : data ){
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+
+    static const char* digits = "0123456789abcdef";
+    std::string result(16, '0');
+    for ( int i = 15; i >= 0; --i ){
+        result[static_cast<size_t>(i)] = digits[h & 0xf];
+        h >>= 4;
+    }
+    return result;
+}
+
+std::string CompileCache::entryPath(const std::string &filePath) const{
+    return Path::join(m_path, hash(filePath) + ".json");
+}
+
+}} // namespace lv, el
@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVCOMPILECACHE_H
+#define LVCOMPILECACHE_H
+
+#include "live/mlnode.h"
+#include "live/fileio.h"
+
+#include <string>
+#include <list>
+#include <mutex>
+#include <atomic>
+
+namespace lv{ namespace el{
+
+/**
+ * \class CompileCache
+ * \brief On-disk cache of compiled module files
+ *
+ * Each source file has one entry, stored under the hash of its path. An entry holds what is
+ * needed to resolve the file without parsing it (exports, imports and used types), together
+ * with its last output. The entry is valid while the content and the compiler configuration
+ * hashes match, and its output is reused while the resolved import paths hash matches.
+ */
+class CompileCache{
+
+public:
+    class Entry{
+    public:
+        class Export{
+        public:
+            std::string name;
+            bool        isComponent;
+        };
+
+        class Import{
+        public:
+            std::string uri;
+            std::string as;
+            bool        isRelative;
+        };
+
+        class ImportType{
+        public:
+            std::string importNamespace;
+            std::string name;
+        };
+
+    public:
+        MLNode toMLNode() const;
+        void fromMLNode(const MLNode& node);
+
+        std::string           configHash;
+        std::string           contentHash;
+        std::list<Export>     exports;
+        std::list<Import>     imports;
+        std::list<ImportType> importTypes;
+        std::string           resolutionHash;
+        std::string           output;
+    };
+
+public:
+    CompileCache(const std::string& path, FileIOInterface* fileIO);
+
+    bool find(const std::string& filePath, const std::string& configHash, const std::string& contentHash, Entry& entry);
+    void store(const std::string& filePath, const Entry& entry);
+
+    void addHit(){ ++m_totalHits; }
+    void addMiss(){ ++m_totalMisses; }
+    size_t totalHits() const{ return m_totalHits; }
+    size_t totalMisses() const{ return m_totalMisses; }
+
+    const std::string& path() const{ return m_path; }
+
+    static std::string hash(const std::string& data);
+
+private:
+    std::string entryPath(const std::string& filePath) const;
+
+    std::string         m_path;
+    FileIOInterface*    m_fileIO;
+    std::mutex          m_pathMutex;
+    bool                m_pathCreated;
+    std::atomic<size_t> m_totalHits;
+    std::atomic<size_t> m_totalMisses;
+};
+
+}} // namespace lv, el
+
+#endif // LVCOMPILECACHE_H
@@ -22,19 +22,65 @@
 #include "elementssections_p.h"
 #include "elementsmodule.h"
 #include "tracepointexception.h"
+#include "compilescheduler_p.h"
+#include "compilecache_p.h"
+#include "compilertrace_p.h"
+#include "jscompactor_p.h"
+#include "outputqueue_p.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 namespace lv{ namespace el {
 
+namespace{
+
+std::vector<ElementsModule*> pinnedModules(const std::vector<ElementsModule::Ptr>& modules){
+    std::vector<ElementsModule*> result;
+    for ( const ElementsModule::Ptr& module : modules )
+        result.push_back(module.get());
+    return result;
+}
+
+} // namespace
+
 class CompilerPrivate{
 public:
-    CompilerPrivate(const Compiler::Config& pconfig) : config(pconfig), packageGraph(nullptr){}
+    CompilerPrivate(const Compiler::Config& pconfig) : config(pconfig), compileCache(nullptr), packageGraph(nullptr), prunedBytes(0), outputQueue(nullptr), moduleUseCounter(0){}
 
     Compiler::Config    config;
     LanguageParser::Ptr parser;
+    CompileCache*       compileCache;
 
     PackageGraph* packageGraph;
-    std::map<std::string, ElementsModule::Ptr> loadedModules;
-    std::map<std::string, ElementsModule::Ptr> loadedModulesByPath;
+    std::unordered_map<std::string, ElementsModule::Ptr> loadedModules;
+    std::unordered_map<std::string, ElementsModule::Ptr> loadedModulesByPath;
+    std::unordered_map<std::string, size_t> loadedModulesLastUse;
+    std::unordered_map<ElementsModule*, std::vector<std::string> > loadedModuleKeys;
+    std::atomic<size_t> prunedBytes;
+    OutputQueue* outputQueue;
+    size_t moduleUseCounter;
+
+    void addLoadedModule(const std::string& importKey, const ElementsModule::Ptr& module){
+        loadedModules[importKey] = module;
+        loadedModulesByPath[module->module()->path()] = module;
+        loadedModuleKeys[module.get()].push_back(importKey);
+    }
+
+    void removeLoadedModule(const ElementsModule::Ptr& module){
+        auto keys = loadedModuleKeys.find(module.get());
+        if ( keys != loadedModuleKeys.end() ){
+            for ( const std::string& key : keys->second ){
+                loadedModules.erase(key);
+                loadedModulesLastUse.erase(key);
+            }
+            loadedModuleKeys.erase(keys);
+        }
+        loadedModulesByPath.erase(module->module()->path());
+    }
 
     BaseNode::ConversionContext* createConversionContext(
             const Module::Ptr& module = nullptr,
@@ -50,6 +96,10 @@ public:
         }
         ctx->allowUnresolved = config.m_allowUnresolved;
         ctx->jsImportsEnabled = config.m_enableJsImports;
+        ctx->staticBindings = config.m_staticBindings;
+        ctx->staticDescriptors = config.m_staticDescriptors;
+        ctx->flatInstances = config.m_flatInstances;
+        ctx->compactOutput = config.m_compactOutput;
         ctx->componentPath = componentPath;
         ctx->relativePathFromBuild = relativePathFromBuild;
         if ( config.componentMetaInfoEnabled() ){
@@ -75,9 +125,15 @@ Compiler::Compiler(const Config &opt, PackageGraph* pg)
 {
     m_d->packageGraph = (pg == nullptr) ? new PackageGraph : pg;
     m_d->parser = LanguageParser::createForElements();
+    if ( !m_d->config.m_compileCachePath.empty() )
+        m_d->compileCache = new CompileCache(m_d->config.m_compileCachePath, m_d->config.m_fileIO);
+    if ( m_d->config.m_fileIO )
+        m_d->outputQueue = new OutputQueue(m_d->config.m_fileIO, m_d->config.m_asyncOutput);
 }
 
 Compiler::~Compiler(){
+    delete m_d->outputQueue;
+    delete m_d->compileCache;
     delete m_d;
 }
 
@@ -119,35 +175,72 @@ std::string Compiler::compileToJs(const std::string &path, const std::string &co
 }
 
 std::string Compiler::compileToJs(const std::string &path, const std::string &contents, BaseNode *node){
+    LV_COMPILER_TRACE_SPAN("convert", path);
     std::string result;
     el::JSSection* section = new el::JSSection;
     section->from = 0;
     section->to   = static_cast<int>(contents.size());
 
+    // the node may have been converted against a different source before
+    BaseNode::clearTreeSourceCaches(node);
     auto ctx = m_d->createConversionContext();
 
     LanguageNodesToJs lnt;
     lnt.convert(node, contents, section->m_children, 0, ctx);
     delete ctx;
 
-    std::vector<std::string> flatten;
-    section->flatten(contents, flatten);
-
-    for ( const std::string& s : flatten ){
-        result += s;
-    }
+    OutputBuffer output;
+    section->flatten(contents, output);
+    output.appendTo(result);
+    if ( m_d->config.m_compactOutput )
+        result = JsCompactor::compact(result);
 
     delete section;
 
     if ( m_d->config.m_fileOutput ){
         std::string outputPath = path + m_d->config.m_outputExtension;
-        m_d->config.m_fileIO->writeToFile(outputPath, result);
+        m_d->outputQueue->write(outputPath, result);
+        flushOutput();
     }
 
     return result;
 }
 
 std::string Compiler::compileModuleFileToJs(const Module::Ptr &module, const std::string &path, const std::string &contents, BaseNode *node){
+    BaseNode::clearTreeSourceCaches(node);
+    std::string result = convertModuleFile(module, path, contents, node, nullptr);
+
+    if ( m_d->config.m_fileOutput ){
+        writeModuleFileOutput(module, path, result, !isModuleFileOutputCurrent(module, path));
+    }
+
+    return result;
+}
+
+/**
+ * \brief Checks whether writes are restricted to modified files and the output of \p path is newer than its source
+ */
+bool Compiler::isModuleFileOutputCurrent(const Module::Ptr &module, const std::string &path){
+    std::string outputFile = moduleFileBuildPath(module, path);
+    if ( m_d->config.m_fileOutputOnlyOnModified && Path::exists(outputFile) ){
+        DateTime sourceModifiedStamp = Path::lastModified(path);
+        DateTime outputModifiedStamp = Path::lastModified(outputFile);
+        return !(outputModifiedStamp < sourceModifiedStamp);
+    }
+    return false;
+}
+
+/**
+ * \brief Converts a module file, reusing and storing the js of its top level nodes in \p exportOutput
+ */
+std::string Compiler::convertModuleFile(
+        const Module::Ptr &module,
+        const std::string &path,
+        const std::string &contents,
+        BaseNode *node,
+        std::map<BaseNode *, ConvertedExport> *exportOutput)
+{
+    LV_COMPILER_TRACE_SPAN("convert", path);
     std::string result;
     el::JSSection* section = new el::JSSection;
     section->from = 0;
@@ -186,49 +279,50 @@ std::string Compiler::compileModuleFileToJs(const Module::Ptr &module, const std
 
     auto ctx = m_d->createConversionContext(module, path, relativePathFromOutput.data());
     LanguageNodesToJs lnt;
+    lnt.setExportOutput(exportOutput);
     lnt.convert(node, contents, section->m_children, 0, ctx);
     delete ctx;
 
-    std::vector<std::string> flatten;
-    section->flatten(contents, flatten);
-
-    for ( const std::string& s : flatten ){
-        result += s;
-    }
+    OutputBuffer output;
+    section->flatten(contents, output);
+    output.appendTo(result);
+    if ( m_d->config.m_compactOutput )
+        result = JsCompactor::compact(result);
 
     delete section;
 
-    if ( m_d->config.m_fileOutput ){
-        std::string outputFile = outputPath.data();
-        std::string displayFilePath = path;
-        Utf8::replaceAll(displayFilePath, module->packagePath(), "");
-
-        bool shouldWrite = true;
-        if ( m_d->config.m_fileOutputOnlyOnModified && Path::exists(outputFile) ){
-            DateTime sourceModifiedStamp = Path::lastModified(path);
-            DateTime outputModifiedStamp = Path::lastModified(outputFile);
-            shouldWrite = outputModifiedStamp < sourceModifiedStamp;
-        }
-        if ( shouldWrite && module->context() ){
-            auto package = module->context()->package;
-            if ( !package->release().empty() ){
-                shouldWrite = false;
-                if ( !Path::exists(outputPath.data()) ){
-                    Utf8 msg = Utf8("Released package '%' missing build file: %").format(package->name(), displayFilePath);
-                    THROW_EXCEPTION(lv::Exception, msg, Exception::toCode("~File"));
-                }
-            }
-        }
+    return result;
+}
 
-        if ( shouldWrite ){
-            m_d->config.m_fileIO->writeToFile(outputPath.data(), result);
-            vlog("lvcompiler").v() << "Compiler: Compiled file: " << displayFilePath;
-        } else {
-            vlog("lvcompiler").v() << "Compiler: Skipped file: " << displayFilePath;
+/**
+ * \brief Queues the \p output of the module file at \p path to be written to the build path
+ *
+ * Files of released packages are never written, their build output is required to exist.
+ * The write is skipped if the output file already has the same content.
+ */
+void Compiler::writeModuleFileOutput(const Module::Ptr &module, const std::string &path, const std::string &output, bool shouldWrite){
+    LV_COMPILER_TRACE_SPAN("write", path);
+    std::string outputFile = moduleFileBuildPath(module, path);
+    std::string displayFilePath = path;
+    Utf8::replaceAll(displayFilePath, module->packagePath(), "");
+
+    if ( shouldWrite && module->context() ){
+        auto package = module->context()->package;
+        if ( !package->release().empty() ){
+            shouldWrite = false;
+            if ( !Path::exists(outputFile) ){
+                Utf8 msg = Utf8("Released package '%' missing build file: %").format(package->name(), displayFilePath);
+                THROW_EXCEPTION(lv::Exception, msg, Exception::toCode("~File"));
+            }
         }
     }
 
-    return result;
+    if ( shouldWrite ){
+        m_d->outputQueue->write(outputFile, output);
+        vlog("lvcompiler").v() << "Compiler: Compiled file: " << displayFilePath;
+    } else {
+        vlog("lvcompiler").v() << "Compiler: Skipped file: " << displayFilePath;
+    }
 }
 
 const std::string &Compiler::packageBuildPath() const{
@@ -240,7 +334,7 @@ std::string Compiler::moduleFileBuildPath(const Module::Ptr &plugin, const std::
         return path + m_d->config.m_outputExtension;
     }
 
-    std::string buildPath = createModuleBuildPath(plugin);
+    std::string buildPath = moduleBuildPath(plugin);
     std::string fileName = Path::name(path);
     return Path::join(buildPath, fileName + m_d->config.m_outputExtension);
 }
@@ -253,15 +347,21 @@ std::string Compiler::moduleBuildPath(const Module::Ptr &module){
     return buildDir;
 }
 
+OutputQueue *Compiler::outputQueue() const{
+    return m_d->outputQueue;
+}
 
-std::string Compiler::createModuleBuildPath(const Module::Ptr &module){
-    std::string buildDir = moduleBuildPath(module);
-    if ( !Path::exists(buildDir) )
-        Path::createDirectories(buildDir);
-    return buildDir;
+/**
+ * \brief Waits for the queued output writes, throwing if any of them failed
+ */
+void Compiler::flushOutput(){
+    if ( m_d->outputQueue )
+        m_d->outputQueue->flush();
 }
 
 std::vector<BaseNode *> Compiler::collectProgramExports(const std::string &contents, ProgramNode *node){
+    LV_COMPILER_TRACE_SPAN("collectImportTypes", node->filePath());
+    BaseNode::clearTreeSourceCaches(node);
     auto ctx = m_d->createConversionContext();
     node->collectImportTypes(contents, ctx);
     delete ctx;
@@ -272,6 +372,7 @@ std::vector<BaseNode *> Compiler::collectProgramExports(const std::string &conte
 ProgramNode *Compiler::parseProgramNodes(const std::string& filePath, const std::string &fileName, LanguageParser::AST *ast){
     if ( !ast )
         return nullptr;
+    LV_COMPILER_TRACE_SPAN("visit", filePath);
     BaseNode* root = el::BaseNode::visit(filePath, fileName, ast);
     ProgramNode* pn = dynamic_cast<ProgramNode*>(root);
     return pn;
@@ -289,6 +390,67 @@ const LanguageParser::Ptr &Compiler::parser() const{
     return m_d->parser;
 }
 
+const Compiler::Config &Compiler::config() const{
+    return m_d->config;
+}
+
+/**
+ * \brief Number of module files whose output was taken from the compile cache
+ */
+size_t Compiler::compileCacheHits() const{
+    return m_d->compileCache ? m_d->compileCache->totalHits() : 0;
+}
+
+/**
+ * \brief Number of module files that were converted while the compile cache was enabled
+ */
+size_t Compiler::compileCacheMisses() const{
+    return m_d->compileCache ? m_d->compileCache->totalMisses() : 0;
+}
+
+/**
+ * \brief Source bytes of the module files that were left out because no entry point reaches them
+ */
+size_t Compiler::prunedBytes() const{
+    return m_d->prunedBytes;
+}
+
+/**
+ * \brief Number of output files and assets that were not written because their content was unchanged
+ */
+size_t Compiler::unchangedOutputFiles() const{
+    return m_d->outputQueue ? m_d->outputQueue->totalSkipped() : 0;
+}
+
+void Compiler::addPrunedFile(const std::string &path, size_t bytes){
+    m_d->prunedBytes += bytes;
+    vlog("lvcompiler").v() << "Compiler: Pruned file: " << path << " (" << bytes << " bytes)";
+}
+
+void Compiler::removePrunedFile(const std::string &path, size_t bytes){
+    m_d->prunedBytes -= bytes;
+    vlog("lvcompiler").v() << "Compiler: Restored pruned file: " << path;
+}
+
+CompileCache *Compiler::compileCache() const{
+    return m_d->compileCache;
+}
+
+/**
+ * \brief Hash of the configuration options that change the output of a file
+ */
+std::string Compiler::configHash() const{
+    const Config& c = m_d->config;
+    std::string fingerprint = "1|" + c.m_outputExtension + "|" + c.m_baseComponent + "|" + c.m_baseComponentUri + "|" +
+        c.m_importLocalPath + "|" + c.m_packageBuildPath + "|" +
+        (c.m_enableJsImports ? "1" : "0") + (c.m_enableComponentMetaInfo ? "1" : "0") +
+        (c.m_allowUnresolved ? "1" : "0") + (c.m_outputTypes ? "1" : "0") + (c.m_staticBindings ? "1" : "0") + (c.m_staticDescriptors ? "1" : "0") + (c.m_flatInstances ? "1" : "0") +
+        (c.m_compactOutput ? "1" : "0") + (c.m_moduleBundle ? "1" : "0");
+    for ( const std::string& implicitType : c.m_implicitTypes )
+        fingerprint += "|" + implicitType;
+    return CompileCache::hash(fingerprint);
+}
+
 void Compiler::configureImplicitType(const std::string &type){
     for ( auto it = m_d->config.m_implicitTypes.begin(); it != m_d->config.m_implicitTypes.end(); ++it )
         if ( *it == type )
@@ -321,12 +483,15 @@ std::shared_ptr<ElementsModule> Compiler::compile(Ptr compiler, const std::strin
 
     auto epl = engine ? ElementsModule::create(module, compiler, engine) : ElementsModule::create(module, compiler);
     ElementsModule::addModuleFile(epl, fileName); // add file if it's not there
+    ElementsModule::resolveReachability({epl.get()});
     epl->compile();
+    compiler->trimModuleCache({epl.get()});
 
     return epl;
 }
 
 std::shared_ptr<ElementsModule> Compiler::compileModule(Compiler::Ptr compiler, const std::string &path, Engine *engine){
+    LV_COMPILER_TRACE_SPAN("compileModule", path);
     if ( !Path::exists(path) ){
         THROW_EXCEPTION(lv::Exception, Utf8("Path does not exist: %.").format(path), lv::Exception::toCode("~Path"));
     }
@@ -339,11 +504,14 @@ std::shared_ptr<ElementsModule> Compiler::compileModule(Compiler::Ptr compiler,
     compiler->m_d->packageGraph->loadRunningPackageAndModule(package, module);
 
     auto epl = engine ? ElementsModule::create(module, compiler, engine) : ElementsModule::create(module, compiler);
+    ElementsModule::resolveReachability({epl.get()});
     epl->compile();
+    compiler->trimModuleCache({epl.get()});
     return epl;
 }
 
 std::vector<std::shared_ptr<ElementsModule> > Compiler::compilePackage(Compiler::Ptr compiler, const std::string &path, Engine *engine){
+    LV_COMPILER_TRACE_SPAN("compilePackage", path);
     if ( !Path::exists(path) ){
         THROW_EXCEPTION(lv::Exception, Utf8("Path doesn't exist: %.").format(path), lv::Exception::toCode("~Path"));
     }
@@ -356,22 +524,62 @@ std::vector<std::shared_ptr<ElementsModule> > Compiler::compilePackage(Compiler:
 
     std::vector<std::shared_ptr<ElementsModule> > result;
 
+    // load all modules first, the same way for serial and parallel builds, then compile them
+
     for ( auto it = modules.begin(); it != modules.end(); ++it ){
-        result.push_back(Compiler::compileModule(compiler, *it, engine));
+        if ( !Path::exists(*it) ){
+            THROW_EXCEPTION(lv::Exception, Utf8("Path does not exist: %.").format(*it), lv::Exception::toCode("~Path"));
+        }
+        if ( !Module::existsIn(*it) ){
+            THROW_EXCEPTION(lv::Exception, Utf8("Module not found in: %.").format(*it), lv::Exception::toCode("~Path"));
+        }
+
+        Module::Ptr module = Module::createFromPath(*it);
+        ElementsModule::Ptr epl = compiler->findLoadedModuleByPath(module->path());
+        compiler->m_d->packageGraph->loadRunningPackageAndModule(package, epl ? epl->module() : module);
+        if ( !epl )
+            epl = engine ? ElementsModule::create(module, compiler, engine) : ElementsModule::create(module, compiler);
+        result.push_back(epl);
+    }
+
+    // entry points can be in any module, so reachability covers the whole package up front
+    ElementsModule::resolveReachability(pinnedModules(result));
+
+    size_t buildWorkers = compiler->m_d->config.buildWorkers();
+    if ( buildWorkers == 0 ){
+        for ( auto it = result.begin(); it != result.end(); ++it ){
+            (*it)->compile();
+        }
+        compiler->trimModuleCache(pinnedModules(result));
+        return result;
     }
 
+    // compile the whole package as a single task graph
+    CompileScheduler scheduler(buildWorkers);
+    std::map<ElementsModule*, CompileScheduler::TaskId> scheduled;
+    for ( auto it = result.begin(); it != result.end(); ++it ){
+        (*it)->scheduleCompile(scheduler, scheduled);
+    }
+    scheduler.run();
+    compiler->flushOutput();
+    compiler->trimModuleCache(pinnedModules(result));
+
     return result;
 }
 
 std::shared_ptr<ElementsModule> Compiler::compileImportedModule(Compiler::Ptr compiler, const std::string &importKey, const Module::Ptr& requestingModule, Engine *engine){
+    LV_COMPILER_TRACE_SPAN("compileImportedModule", importKey);
     auto foundEp = compiler->m_d->loadedModules.find(importKey);
     if ( foundEp == compiler->m_d->loadedModules.end() ){
         try{
             Module::Ptr module = compiler->m_d->packageGraph->loadModule(importKey, requestingModule);
             if ( module  ){
-                auto ep = engine ? ElementsModule::create(module , compiler, engine) : ElementsModule::create(module , compiler);
-                compiler->m_d->loadedModules[importKey] = ep;
-                compiler->m_d->loadedModulesByPath[ep->module()->path()] = ep;
+                // modules used by the engine need their files parsed, summaries are only for builds
+                ElementsModule::Ptr ep = engine ? nullptr : ElementsModule::createFromInterface(module, compiler);
+                if ( !ep )
+                    ep = engine ? ElementsModule::create(module , compiler, engine) : ElementsModule::create(module , compiler);
+                compiler->m_d->addLoadedModule(importKey, ep);
+                compiler->m_d->loadedModulesLastUse[importKey] = ++compiler->m_d->moduleUseCounter;
                 return ep;
             }
         } catch ( TracePointException& e ){
@@ -382,6 +590,7 @@ std::shared_ptr<ElementsModule> Compiler::compileImportedModule(Compiler::Ptr co
             throw TracePointException(e);
         }
     } else {
+        compiler->m_d->loadedModulesLastUse[importKey] = ++compiler->m_d->moduleUseCounter;
         return foundEp->second;
     }
     return nullptr;
@@ -395,14 +604,144 @@ void Compiler::setPackageImportPaths(const std::vector<std::string> &paths){
     m_d->packageGraph->setPackageImportPaths(paths);
 }
 
+/**
+ * \brief Finds a loaded module by its path, which is only resolved if it does not match a module path as given
+ */
 std::shared_ptr<ElementsModule> Compiler::findLoadedModuleByPath(const std::string &path) const{
     auto it = m_d->loadedModulesByPath.find(path);
     if ( it != m_d->loadedModulesByPath.end() ){
         return it->second;
     }
+    it = m_d->loadedModulesByPath.find(Path::resolve(path));
+    if ( it != m_d->loadedModulesByPath.end() ){
+        return it->second;
+    }
     return nullptr;
 }
 
+/**
+ * \brief Collects \p module followed by the modules that import it, directly or not
+ *
+ * Follows the importer edges of each module. Returns false if one of the importers is not held
+ * by the loaded module cache. Its owner still uses the collected modules, so they cannot be
+ * unloaded.
+ */
+bool Compiler::collectImporters(const ElementsModule::Ptr &module, std::vector<ElementsModule::Ptr>& result) const{
+    std::set<ElementsModule*> found;
+    result.push_back(module);
+    found.insert(module.get());
+    for ( size_t i = 0; i < result.size(); ++i ){
+        for ( ElementsModule* importer : result[i]->importers() ){
+            if ( !found.insert(importer).second )
+                continue;
+            auto it = m_d->loadedModulesByPath.find(importer->module()->path());
+            if ( it == m_d->loadedModulesByPath.end() || it->second.get() != importer )
+                return false;
+            result.push_back(it->second);
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Unloads the module at \p path, together with the loaded modules that import it
+ *
+ * Returns the number of unloaded modules. These are loaded again the next time they are
+ * imported. Pointers to unloaded modules that are held elsewhere must not be used anymore.
+ * Throws if the module is imported by a module that was not loaded by this compiler, such as
+ * one returned by compileModule().
+ */
+size_t Compiler::unloadModule(const std::string &path){
+    ElementsModule::Ptr epl = findLoadedModuleByPath(path);
+    if ( !epl )
+        return 0;
+
+    std::vector<ElementsModule::Ptr> modules;
+    if ( !collectImporters(epl, modules) ){
+        THROW_EXCEPTION(
+            lv::Exception,
+            Utf8("Cannot unload module '%', it is still imported by a module that is not loaded by the compiler.").format(path),
+            lv::Exception::toCode("~Module")
+        );
+    }
+
+    // importers first, so no file is left pointing into an unloaded module
+    for ( auto it = modules.rbegin(); it != modules.rend(); ++it ){
+        vlog("lvcompiler").v() << "Compiler: Unloaded module: " << (*it)->module()->path();
+        m_d->removeLoadedModule(*it);
+        (*it)->unload();
+    }
+    return modules.size();
+}
+
+size_t Compiler::totalLoadedModules() const{
+    return m_d->loadedModulesByPath.size();
+}
+
+/**
+ * \brief Bytes held by the loaded modules, which the module cache capacity is checked against
+ */
+size_t Compiler::loadedModulesSize() const{
+    size_t size = 0;
+    for ( auto it = m_d->loadedModulesByPath.begin(); it != m_d->loadedModulesByPath.end(); ++it )
+        size += it->second->memorySize();
+    return size;
+}
+
+/**
+ * \brief Unloads the least recently used modules until the loaded modules fit the cache capacity
+ *
+ * A module is unloaded together with the modules importing it. It is kept if one of them is
+ * \p pinned, or is not held by the cache. Top level modules are owned by whoever compiled
+ * them, so the modules they import stay loaded until they are released.
+ */
+void Compiler::trimModuleCache(const std::vector<ElementsModule *> &pinned){
+    size_t capacity = m_d->config.m_moduleCacheCapacity;
+    if ( capacity == 0 )
+        return;
+
+    size_t size = loadedModulesSize();
+    if ( size <= capacity )
+        return;
+
+    std::set<ElementsModule*> keep(pinned.begin(), pinned.end());
+
+    std::vector<std::pair<size_t, std::string> > byUse;
+    for ( auto it = m_d->loadedModulesLastUse.begin(); it != m_d->loadedModulesLastUse.end(); ++it )
+        byUse.push_back(std::make_pair(it->second, it->first));
+    std::sort(byUse.begin(), byUse.end());
+
+    for ( const auto& use : byUse ){
+        if ( size <= capacity )
+            break;
+        auto found = m_d->loadedModules.find(use.second);
+        if ( found == m_d->loadedModules.end() )
+            continue; // already unloaded as an importer
+
+        std::vector<ElementsModule::Ptr> modules;
+        if ( !collectImporters(found->second, modules) )
+            continue;
+
+        bool canUnload = true;
+        for ( const ElementsModule::Ptr& module : modules ){
+            if ( keep.find(module.get()) != keep.end() ){
+                canUnload = false;
+                break;
+            }
+        }
+        if ( !canUnload )
+            continue;
+
+        for ( auto it = modules.rbegin(); it != modules.rend(); ++it ){
+            size_t moduleSize = (*it)->memorySize();
+            size = size > moduleSize ? size - moduleSize : 0;
+            vlog("lvcompiler").v() << "Compiler: Evicted module: " << (*it)->module()->path();
+            m_d->removeLoadedModule(*it);
+            (*it)->unload();
+        }
+    }
+}
+
 Compiler::Config::Config(bool fileOutput, const std::string &outputExtension, FileIOInterface *ioInterface)
     : m_fileOutput(fileOutput)
     , m_fileOutputOnlyOnModified(true)
@@ -411,6 +750,16 @@ Compiler::Config::Config(bool fileOutput, const std::string &outputExtension, Fi
     , m_enableJsImports(true)
     , m_enableComponentMetaInfo(true)
     , m_allowUnresolved(true)
+    , m_outputTypes(false)
+    , m_buildWorkers(0)
+    , m_staticBindings(false)
+    , m_staticDescriptors(false)
+    , m_flatInstances(false)
+    , m_compactOutput(false)
+    , m_moduleBundle(false)
+    , m_asyncOutput(false)
+    , m_releaseAfterCompile(false)
+    , m_moduleCacheCapacity(0)
 {
     if ( m_fileOutput && !m_fileIO ){
         THROW_EXCEPTION(lv::Exception, "File reader & writer not defined for compiler.", lv::Exception::toCode("~FileIO"));
@@ -420,6 +769,18 @@ Compiler::Config::Config(bool fileOutput, const std::string &outputExtension, Fi
     }
 }
 
+/**
+ * \brief Number of threads used to compile, 0 compiles serially on the calling thread
+ *
+ * A negative setting uses all hardware threads. A setting of 1 runs the task graph on a single
+ * worker thread.
+ */
+size_t Compiler::Config::buildWorkers() const{
+    if ( m_buildWorkers < 0 )
+        return CompileScheduler::defaultWorkerCount();
+    return static_cast<size_t>(m_buildWorkers);
+}
+
 void Compiler::Config::addImplicitType(const std::string &typeName){
     m_implicitTypes.push_back(typeName);
 }
@@ -428,6 +789,10 @@ void Compiler::Config::addImportPath(const std::string &path){
     m_importPaths.push_back(path);
 }
 
+void Compiler::Config::addEntryPoint(const std::string &filePath){
+    m_entryPoints.push_back(filePath);
+}
+
 void Compiler::Config::setBaseComponent(const std::string &name, const std::string &importUri){
     m_baseComponent = name;
     m_baseComponentUri = importUri;
@@ -472,6 +837,44 @@ void Compiler::Config::initialize(const MLNode &config){
     if ( config.hasKey("enableComponentMetaInfo") ){
         m_enableComponentMetaInfo = config["enableComponentMetaInfo"].asBool();
     }
+    if ( config.hasKey("buildWorkers") ){
+        m_buildWorkers = static_cast<int>(config["buildWorkers"].asInt());
+    }
+    if ( config.hasKey("compileCachePath") ){
+        m_compileCachePath = config["compileCachePath"].asString();
+    }
+    if ( config.hasKey("staticBindings") ){
+        m_staticBindings = config["staticBindings"].asBool();
+    }
+    if ( config.hasKey("staticDescriptors") ){
+        m_staticDescriptors = config["staticDescriptors"].asBool();
+    }
+    if ( config.hasKey("flatInstances") ){
+        m_flatInstances = config["flatInstances"].asBool();
+    }
+    if ( config.hasKey("compactOutput") ){
+        m_compactOutput = config["compactOutput"].asBool();
+    }
+    if ( config.hasKey("moduleBundle") ){
+        m_moduleBundle = config["moduleBundle"].asBool();
+    }
+    if ( config.hasKey("asyncOutput") ){
+        m_asyncOutput = config["asyncOutput"].asBool();
+    }
+    if ( config.hasKey("releaseAfterCompile") ){
+        m_releaseAfterCompile = config["releaseAfterCompile"].asBool();
+    }
+    if ( config.hasKey("moduleCacheCapacity") ){
+        // negative capacities mean no limit, same as 0
+        auto capacity = config["moduleCacheCapacity"].asInt();
+        m_moduleCacheCapacity = capacity > 0 ? static_cast<size_t>(capacity) : 0;
+    }
+    if ( config.hasKey("entryPoints") ){
+        MLNode::ArrayType a = config["entryPoints"].asArray();
+        for ( const MLNode& n : a ){
+            addEntryPoint(n.asString());
+        }
+    }
 }
 
 }} // namespace lv, el
@@ -23,6 +23,8 @@
 #include "live/package.h"
 #include "live/module.h"
 
+#include <map>
+
 namespace lv{
 
 class MLNode;
@@ -30,8 +32,11 @@ class MLNode;
 namespace el{
 
 class BaseNode;
+class ConvertedExport;
 class ProgramNode;
 class ElementsModule;
+class CompileCache;
+class OutputQueue;
 class CompilerPrivate;
 class LV_ELEMENTS_COMPILER_EXPORT Compiler{
 
@@ -53,12 +58,35 @@ public:
 
         bool hasCustomBaseComponent();
         bool componentMetaInfoEnabled();
+        bool fileOutputEnabled() const{ return m_fileOutput; }
         void addImplicitType(const std::string& typeName);
         void addImportPath(const std::string& path);
         void setBaseComponent(const std::string& name, const std::string& importUri);
         void initialize(const MLNode& config);
         void allowUnresolvedTypes(bool allow){ m_allowUnresolved = allow; }
         void outputTypes(bool outputTypes) { m_outputTypes = outputTypes; }
+        void setBuildWorkers(int workers){ m_buildWorkers = workers; }
+        size_t buildWorkers() const;
+        void setCompileCachePath(const std::string& path){ m_compileCachePath = path; }
+        const std::string& compileCachePath() const{ return m_compileCachePath; }
+        void enableStaticBindings(bool enable){ m_staticBindings = enable; }
+        bool staticBindingsEnabled() const{ return m_staticBindings; }
+        void enableStaticDescriptors(bool enable){ m_staticDescriptors = enable; }
+        bool staticDescriptorsEnabled() const{ return m_staticDescriptors; }
+        void enableFlatInstances(bool enable){ m_flatInstances = enable; }
+        bool flatInstancesEnabled() const{ return m_flatInstances; }
+        void enableCompactOutput(bool enable){ m_compactOutput = enable; }
+        bool compactOutputEnabled() const{ return m_compactOutput; }
+        void enableModuleBundle(bool enable){ m_moduleBundle = enable; }
+        bool moduleBundleEnabled() const{ return m_moduleBundle; }
+        void enableAsyncOutput(bool enable){ m_asyncOutput = enable; }
+        bool asyncOutputEnabled() const{ return m_asyncOutput; }
+        void enableReleaseAfterCompile(bool enable){ m_releaseAfterCompile = enable; }
+        bool releaseAfterCompileEnabled() const{ return m_releaseAfterCompile; }
+        void setModuleCacheCapacity(size_t bytes){ m_moduleCacheCapacity = bytes; }
+        size_t moduleCacheCapacity() const{ return m_moduleCacheCapacity; }
+        void addEntryPoint(const std::string& filePath);
+        const std::list<std::string>& entryPoints() const{ return m_entryPoints; }
     private:
         bool                   m_fileOutput;
         bool                   m_fileOutputOnlyOnModified;
@@ -75,6 +103,17 @@ public:
         bool                   m_enableComponentMetaInfo;
         bool                   m_allowUnresolved;
         bool                   m_outputTypes;
+        int                    m_buildWorkers;
+        std::string            m_compileCachePath;
+        bool                   m_staticBindings;
+        bool                   m_staticDescriptors;
+        bool                   m_flatInstances;
+        bool                   m_compactOutput;
+        bool                   m_moduleBundle;
+        bool                   m_asyncOutput;
+        bool                   m_releaseAfterCompile;
+        size_t                 m_moduleCacheCapacity;
+        std::list<std::string> m_entryPoints;
     };
 
 public:
@@ -101,6 +140,12 @@ public:
     const std::string& outputExtension() const;
     const std::string& importLocalPath() const;
     const LanguageParser::Ptr& parser() const;
+    const Config& config() const;
+
+    size_t compileCacheHits() const;
+    size_t compileCacheMisses() const;
+    size_t prunedBytes() const;
+    size_t unchangedOutputFiles() const;
 
     void configureImplicitType(const std::string& type);
 
@@ -113,9 +158,32 @@ public:
     void setPackageImportPaths(const std::vector<std::string>& paths);
 
     std::shared_ptr<ElementsModule> findLoadedModuleByPath(const std::string& path) const;
+    size_t unloadModule(const std::string& path);
+    size_t totalLoadedModules() const;
+    size_t loadedModulesSize() const;
 
 private:
-    std::string createModuleBuildPath(const Module::Ptr& plugin);
+    friend class ModuleFile;
+    friend class ElementsModule;
+
+    OutputQueue* outputQueue() const;
+    void flushOutput();
+    std::string convertModuleFile(
+        const Module::Ptr& plugin,
+        const std::string& path,
+        const std::string& content,
+        BaseNode* node,
+        std::map<BaseNode*, ConvertedExport>* exportOutput
+    );
+    bool isModuleFileOutputCurrent(const Module::Ptr& plugin, const std::string& path);
+    void addPrunedFile(const std::string& path, size_t bytes);
+    void removePrunedFile(const std::string& path, size_t bytes);
+    void writeModuleFileOutput(const Module::Ptr& plugin, const std::string& path, const std::string& output, bool shouldWrite);
+
+    CompileCache* compileCache() const;
+    std::string configHash() const;
+    void trimModuleCache(const std::vector<ElementsModule*>& pinned);
+    bool collectImporters(const std::shared_ptr<ElementsModule>& module, std::vector<std::shared_ptr<ElementsModule> >& result) const;
 
     Compiler(const Config& config, PackageGraph *pg);
 
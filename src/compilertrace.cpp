@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "compilertrace.h"
+#include "live/fileio.h"
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+
+namespace lv{ namespace el{
+
+namespace{
+
+class TraceEvent{
+public:
+    const char* name;
+    std::string tag;
+    size_t      threadId;
+    long long   start;
+    long long   duration;
+};
+
+class TraceLog{
+public:
+    TraceLog() : recording(false), start(std::chrono::steady_clock::now()), nextThreadId(0){}
+
+    std::atomic<bool>                     recording;
+    std::chrono::steady_clock::time_point start;
+    std::mutex                            eventsMutex;
+    std::vector<TraceEvent>               events;
+    std::atomic<size_t>                   nextThreadId;
+};
+
+TraceLog& traceLog(){
+    static TraceLog log;
+    return log;
+}
+
+size_t currentThreadId(){
+    thread_local size_t threadId = traceLog().nextThreadId++;
+    return threadId;
+}
+
+void appendJsonString(std::string& out, const std::string& value){
+    out += '"';
+    for ( char c : value ){
+        switch ( c ){
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if ( static_cast<unsigned char>(c) < 0x20 ){
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+CompilerTrace::Span::Span(const char *name, const std::string &tag)
+    : m_name(name)
+    , m_recording(traceLog().recording.load(std::memory_order_relaxed))
+{
+    if ( m_recording ){
+        m_tag = tag;
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+CompilerTrace::Span::~Span(){
+    if ( !m_recording )
+        return;
+
+    TraceLog& log = traceLog();
+    auto end = std::chrono::steady_clock::now();
+
+    TraceEvent event;
+    event.name     = m_name;
+    event.tag      = std::move(m_tag);
+    event.threadId = currentThreadId();
+    event.start    = std::chrono::duration_cast<std::chrono::microseconds>(m_start - log.start).count();
+    event.duration = std::chrono::duration_cast<std::chrono::microseconds>(end - m_start).count();
+
+    std::lock_guard<std::mutex> guard(log.eventsMutex);
+    log.events.push_back(std::move(event));
+}
+
+/**
+ * \brief Returns true if the library was built with spans compiled in
+ */
+bool CompilerTrace::isAvailable(){
+#ifdef LV_ELEMENTS_COMPILER_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * \brief Starts or stops recording spans
+ */
+void CompilerTrace::setRecording(bool recording){
+    traceLog().recording = recording;
+}
+
+bool CompilerTrace::isRecording(){
+    return traceLog().recording;
+}
+
+/**
+ * \brief Drops the recorded spans
+ */
+void CompilerTrace::clear(){
+    TraceLog& log = traceLog();
+    std::lock_guard<std::mutex> guard(log.eventsMutex);
+    log.events.clear();
+}
+
+size_t CompilerTrace::totalEvents(){
+    TraceLog& log = traceLog();
+    std::lock_guard<std::mutex> guard(log.eventsMutex);
+    return log.events.size();
+}
+
+/**
+ * \brief Returns the recorded spans as complete events in the Chrome trace event format
+ */
+std::string CompilerTrace::toChromeTraceJson(){
+    TraceLog& log = traceLog();
+    std::lock_guard<std::mutex> guard(log.eventsMutex);
+
+    std::string result = "{\"traceEvents\":[";
+    for ( size_t i = 0; i < log.events.size(); ++i ){
+        const TraceEvent& event = log.events[i];
+        if ( i > 0 )
+            result += ",";
+        result += "\n{\"name\":";
+        appendJsonString(result, event.name);
+        result += ",\"cat\":\"lvcompiler\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(event.threadId);
+        result += ",\"ts\":" + std::to_string(event.start) + ",\"dur\":" + std::to_string(event.duration);
+        result += ",\"args\":{\"tag\":";
+        appendJsonString(result, event.tag);
+        result += "}}";
+    }
+    result += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return result;
+}
+
+void CompilerTrace::writeChromeTrace(const std::string &path){
+    FileIO fileIO;
+    fileIO.writeToFile(path, toChromeTraceJson());
+}
+
+}} // namespace lv, el
@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVCOMPILERTRACE_H
+#define LVCOMPILERTRACE_H
+
+#include "live/elements/compiler/lvelcompilerglobal.h"
+
+#include <string>
+#include <chrono>
+
+namespace lv{ namespace el{
+
+/**
+ * \class CompilerTrace
+ * \brief Records timed spans of the compile phases and exports them as Chrome trace events
+ *
+ * Spans are only compiled in when the library is built with LV_ELEMENTS_COMPILER_TRACE, and only
+ * recorded while recording is on. The resulting json can be opened in chrome://tracing or Perfetto.
+ */
+class LV_ELEMENTS_COMPILER_EXPORT CompilerTrace{
+
+public:
+    /**
+     * \class lv::el::CompilerTrace::Span
+     * \brief Scoped span, recorded when it goes out of scope
+     */
+    class LV_ELEMENTS_COMPILER_EXPORT Span{
+
+        DISABLE_COPY(Span);
+
+    public:
+        Span(const char* name, const std::string& tag);
+        ~Span();
+
+    private:
+        const char* m_name;
+        std::string m_tag;
+        bool        m_recording;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+public:
+    static bool isAvailable();
+
+    static void setRecording(bool recording);
+    static bool isRecording();
+
+    static void clear();
+    static size_t totalEvents();
+
+    static std::string toChromeTraceJson();
+    static void writeChromeTrace(const std::string& path);
+
+private:
+    CompilerTrace(){}
+};
+
+}} // namespace lv, el
+
+#endif // LVCOMPILERTRACE_H
@@ -0,0 +1,37 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVCOMPILERTRACE_P_H
+#define LVCOMPILERTRACE_P_H
+
+#include "compilertrace.h"
+
+#define LV_COMPILER_TRACE_CAT2(a, b) a##b
+#define LV_COMPILER_TRACE_CAT(a, b) LV_COMPILER_TRACE_CAT2(a, b)
+
+/**
+ * Opens a span named \p name until the end of the current scope, tagged with \p tag (the file or
+ * module it applies to). Expands to nothing unless LV_ELEMENTS_COMPILER_TRACE is defined, in which
+ * case the tag is not evaluated either.
+ */
+#ifdef LV_ELEMENTS_COMPILER_TRACE
+#define LV_COMPILER_TRACE_SPAN(name, tag) \
+    lv::el::CompilerTrace::Span LV_COMPILER_TRACE_CAT(lvCompilerTraceSpan, __LINE__)(name, tag)
+#else
+#define LV_COMPILER_TRACE_SPAN(name, tag)
+#endif
+
+#endif // LVCOMPILERTRACE_P_H
@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "compilescheduler_p.h"
+
+#include <thread>
+
+namespace lv{ namespace el{
+
+CompileScheduler::CompileScheduler(size_t workers)
+    : m_totalWorkers(workers == 0 ? 1 : workers)
+    , m_remaining(0)
+    , m_aborted(false)
+    , m_queued(0)
+    , m_failedTask(0)
+    , m_failure(nullptr)
+{
+    for ( size_t i = 0; i < m_totalWorkers; ++i ){
+        m_workers.push_back(new Worker);
+    }
+}
+
+CompileScheduler::~CompileScheduler(){
+    for ( auto it = m_workers.begin(); it != m_workers.end(); ++it ){
+        delete *it;
+    }
+}
+
+CompileScheduler::TaskId CompileScheduler::addTask(const std::function<void ()> &fn){
+    m_tasks.push_back(Task(fn));
+    return m_tasks.size() - 1;
+}
+
+void CompileScheduler::addDependency(TaskId task, TaskId dependency){
+    if ( task == dependency )
+        return;
+    m_tasks[dependency].dependents.push_back(task);
+    ++m_tasks[task].pendingDependencies;
+}
+
+void CompileScheduler::run(){
+    if ( m_tasks.empty() )
+        return;
+
+    if ( !isAcyclic() ){
+        THROW_EXCEPTION(lv::Exception, "Compile task dependency cycle found.", lv::Exception::toCode("Cycle"));
+    }
+
+    m_remaining = m_tasks.size();
+    m_aborted   = false;
+    m_failure   = nullptr;
+
+    // distribute the initially ready tasks in their original order
+    size_t workerIndex = 0;
+    for ( size_t i = 0; i < m_tasks.size(); ++i ){
+        if ( m_tasks[i].pendingDependencies == 0 ){
+            pushTask(workerIndex, i);
+            workerIndex = (workerIndex + 1) % m_totalWorkers;
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for ( size_t i = 1; i < m_totalWorkers; ++i ){
+        threads.push_back(std::thread(&CompileScheduler::workerLoop, this, i));
+    }
+    workerLoop(0);
+
+    for ( auto it = threads.begin(); it != threads.end(); ++it ){
+        it->join();
+    }
+
+    if ( m_failure ){
+        std::exception_ptr failure = m_failure;
+        m_failure = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+size_t CompileScheduler::defaultWorkerCount(){
+    unsigned int concurrency = std::thread::hardware_concurrency();
+    return concurrency == 0 ? 1 : concurrency;
+}
+
+bool CompileScheduler::isAcyclic() const{
+    std::vector<size_t> pending(m_tasks.size());
+    std::vector<TaskId> ready;
+    for ( size_t i = 0; i < m_tasks.size(); ++i ){
+        pending[i] = m_tasks[i].pendingDependencies;
+        if ( pending[i] == 0 )
+            ready.push_back(i);
+    }
+
+    size_t visited = 0;
+    while ( !ready.empty() ){
+        TaskId task = ready.back();
+        ready.pop_back();
+        ++visited;
+        for ( auto it = m_tasks[task].dependents.begin(); it != m_tasks[task].dependents.end(); ++it ){
+            if ( --pending[*it] == 0 )
+                ready.push_back(*it);
+        }
+    }
+    return visited == m_tasks.size();
+}
+
+void CompileScheduler::workerLoop(size_t index){
+    while ( true ){
+        TaskId task;
+        if ( takeTask(index, task) ){
+            try{
+                m_tasks[task].run();
+                completeTask(index, task);
+            } catch ( ... ){
+                failTask(task, std::current_exception());
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_stateChanged.wait(lock, [this]{ return m_remaining == 0 || m_aborted || m_queued > 0; });
+        if ( m_remaining == 0 || m_aborted )
+            return;
+    }
+}
+
+bool CompileScheduler::takeTask(size_t index, TaskId &task){
+    // own queue is consumed in order, idle workers steal from the back of the others
+    for ( size_t i = 0; i < m_totalWorkers; ++i ){
+        Worker* worker = m_workers[(index + i) % m_totalWorkers];
+        std::lock_guard<std::mutex> guard(worker->mutex);
+        if ( worker->queue.empty() )
+            continue;
+        if ( i == 0 ){
+            task = worker->queue.front();
+            worker->queue.pop_front();
+        } else {
+            task = worker->queue.back();
+            worker->queue.pop_back();
+        }
+        --m_queued;
+        return true;
+    }
+    return false;
+}
+
+void CompileScheduler::pushTask(size_t index, TaskId task){
+    Worker* worker = m_workers[index];
+    {
+        std::lock_guard<std::mutex> guard(worker->mutex);
+        worker->queue.push_back(task);
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        ++m_queued;
+    }
+    m_stateChanged.notify_one();
+}
+
+void CompileScheduler::completeTask(size_t index, TaskId task){
+    for ( auto it = m_tasks[task].dependents.begin(); it != m_tasks[task].dependents.end(); ++it ){
+        if ( --m_tasks[*it].pendingDependencies == 0 ){
+            pushTask(index, *it);
+        }
+    }
+
+    if ( --m_remaining == 0 ){
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        m_stateChanged.notify_all();
+    }
+}
+
+void CompileScheduler::failTask(TaskId task, std::exception_ptr e){
+    {
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        if ( !m_failure || task < m_failedTask ){
+            m_failure = e;
+            m_failedTask = task;
+        }
+        m_aborted = true;
+    }
+    m_stateChanged.notify_all();
+}
+
+}} // namespace lv, el
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVCOMPILESCHEDULER_H
+#define LVCOMPILESCHEDULER_H
+
+#include "live/elements/compiler/lvelcompilerglobal.h"
+#include "live/exception.h"
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+namespace lv{ namespace el{
+
+/**
+ * \class CompileScheduler
+ * \brief Runs a graph of compilation tasks on a work-stealing thread pool.
+ *
+ * A task becomes ready once every task it depends on has finished. Ready tasks are pushed
+ * to the queue of the worker that released them, idle workers steal from the other queues.
+ * If tasks fail, the exception of the first added failing task is rethrown from run().
+ */
+class CompileScheduler{
+
+    DISABLE_COPY(CompileScheduler);
+
+public:
+    typedef size_t TaskId;
+
+private:
+    class Task{
+    public:
+        Task(const std::function<void()>& fn) : run(fn), pendingDependencies(0){}
+        Task(const Task& other) : run(other.run), pendingDependencies(other.pendingDependencies.load()), dependents(other.dependents){}
+
+        std::function<void()> run;
+        std::atomic<size_t>   pendingDependencies;
+        std::vector<TaskId>   dependents;
+    };
+
+    class Worker{
+    public:
+        std::mutex         mutex;
+        std::deque<TaskId> queue;
+    };
+
+public:
+    CompileScheduler(size_t workers);
+    ~CompileScheduler();
+
+    TaskId addTask(const std::function<void()>& fn);
+    void addDependency(TaskId task, TaskId dependency);
+
+    size_t totalTasks() const;
+    size_t totalWorkers() const;
+
+    void run();
+
+    static size_t defaultWorkerCount();
+
+private:
+    bool isAcyclic() const;
+    void workerLoop(size_t index);
+    bool takeTask(size_t index, TaskId& task);
+    void pushTask(size_t index, TaskId task);
+    void completeTask(size_t index, TaskId task);
+    void failTask(TaskId task, std::exception_ptr e);
+
+    size_t                  m_totalWorkers;
+    std::vector<Task>       m_tasks;
+    std::vector<Worker*>    m_workers;
+
+    std::mutex              m_stateMutex;
+    std::condition_variable m_stateChanged;
+    std::atomic<size_t>     m_remaining;
+    std::atomic<bool>       m_aborted;
+    std::atomic<size_t>     m_queued;
+
+    TaskId                  m_failedTask;
+    std::exception_ptr      m_failure;
+};
+
+inline size_t CompileScheduler::totalTasks() const{
+    return m_tasks.size();
+}
+
+inline size_t CompileScheduler::totalWorkers() const{
+    return m_totalWorkers;
+}
+
+}} // namespace lv, el
+
+#endif // LVCOMPILESCHEDULER_H
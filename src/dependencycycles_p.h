@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVDEPENDENCYCYCLES_H
+#define LVDEPENDENCYCYCLES_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace lv{ namespace el{
+
+/**
+ * \class DependencyCycles
+ * \brief Finds a dependency cycle among nodes of type \p T, given the dependencies of each node
+ *
+ * Dependencies are expected in the order their edges were added, and the nodes in the order
+ * they added their edges.
+ */
+template<typename T>
+class DependencyCycles{
+
+public:
+    typedef std::function<const std::list<T*>& (T*)> DependenciesFunction;
+    typedef std::function<std::string (T*)>          NameFunction;
+
+public:
+    static std::list<T*> find(const std::vector<T*>& nodes, const DependenciesFunction& dependencies);
+    static std::string toString(const std::list<T*>& path, const NameFunction& name);
+
+private:
+    class Frame{
+    public:
+        T* node;
+        typename std::list<T*>::const_iterator next;
+    };
+
+    static bool findPathBack(
+        T* start,
+        const std::unordered_map<T*, size_t>& order,
+        const DependenciesFunction& dependencies,
+        std::list<T*>& path
+    );
+};
+
+/**
+ * \brief Returns the path of a cycle among the nodes reachable from \p nodes, or an empty list
+ *
+ * Strongly connected components are found with Tarjan's algorithm, in a single pass over the
+ * edges. Once a cycle is known to exist, the path is the one that adding the edges in order
+ * would have closed first: it starts at the node whose edge closed it and follows the edges
+ * depth first, in the order they were added.
+ */
+template<typename T>
+std::list<T*> DependencyCycles<T>::find(const std::vector<T*>& nodes, const DependenciesFunction& dependencies){
+    std::unordered_map<T*, size_t> index;
+    std::unordered_map<T*, size_t> lowLink;
+    std::unordered_set<T*> onStack;
+    std::vector<T*> stack;
+    std::vector<Frame> frames;
+    T* componentNode = nullptr;
+
+    auto visit = [&index, &lowLink, &onStack, &stack, &frames, &dependencies](T* node){
+        size_t i = index.size();
+        index[node] = i;
+        lowLink[node] = i;
+        stack.push_back(node);
+        onStack.insert(node);
+        frames.push_back({node, dependencies(node).begin()});
+    };
+
+    for ( T* root : nodes ){
+        if ( index.find(root) != index.end() )
+            continue;
+        visit(root);
+
+        while ( !frames.empty() && !componentNode ){
+            Frame& frame = frames.back();
+            if ( frame.next != dependencies(frame.node).end() ){
+                T* dependency = *frame.next;
+                ++frame.next;
+                if ( index.find(dependency) == index.end() ){
+                    visit(dependency);
+                } else if ( onStack.find(dependency) != onStack.end() ){
+                    lowLink[frame.node] = std::min(lowLink[frame.node], index[dependency]);
+                }
+                continue;
+            }
+
+            T* node = frame.node;
+            frames.pop_back();
+            if ( !frames.empty() )
+                lowLink[frames.back().node] = std::min(lowLink[frames.back().node], lowLink[node]);
+
+            if ( lowLink[node] == index[node] ){
+                size_t componentSize = 0;
+                T* member = nullptr;
+                do{
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack.erase(member);
+                    ++componentSize;
+                } while ( member != node );
+
+                if ( componentSize > 1 )
+                    componentNode = node;
+            }
+        }
+
+        if ( componentNode )
+            break;
+    }
+
+    std::list<T*> path;
+    if ( !componentNode )
+        return path;
+
+    // nodes that are not listed added their edges before all the listed ones
+    std::unordered_map<T*, size_t> order;
+    for ( size_t i = 0; i < nodes.size(); ++i )
+        order.insert(std::make_pair(nodes[i], i));
+
+    for ( T* node : nodes ){
+        if ( findPathBack(node, order, dependencies, path) )
+            return path;
+    }
+    // the cycle is only reachable from the nodes
+    findPathBack(componentNode, order, dependencies, path);
+    return path;
+}
+
+/**
+ * \brief Joins the names of the nodes in \p path with arrows
+ */
+template<typename T>
+std::string DependencyCycles<T>::toString(const std::list<T*>& path, const NameFunction& name){
+    std::string result;
+    for ( auto it = path.begin(); it != path.end(); ++it ){
+        if ( it != path.begin() )
+            result += " -> ";
+        result += name(*it);
+    }
+    return result;
+}
+
+/**
+ * \brief Follows the edges of \p start depth first, through the nodes that added their edges
+ * before it, back to \p start
+ */
+template<typename T>
+bool DependencyCycles<T>::findPathBack(
+        T* start,
+        const std::unordered_map<T*, size_t>& order,
+        const DependenciesFunction& dependencies,
+        std::list<T*>& path)
+{
+    auto startIt = order.find(start);
+    size_t startOrder = startIt != order.end() ? startIt->second : order.size();
+    auto hasEdges = [&order, startOrder](T* node){
+        auto it = order.find(node);
+        return it == order.end() || it->second < startOrder;
+    };
+
+    std::unordered_set<T*> visited;
+    std::vector<Frame> frames;
+    frames.push_back({start, dependencies(start).begin()});
+    while ( !frames.empty() ){
+        Frame& frame = frames.back();
+        if ( frame.next == dependencies(frame.node).end() ){
+            frames.pop_back();
+            continue;
+        }
+
+        T* dependency = *frame.next;
+        ++frame.next;
+        if ( dependency == start ){
+            for ( const Frame& f : frames )
+                path.push_back(f.node);
+            path.push_back(start);
+            return true;
+        }
+        if ( hasEdges(dependency) && visited.insert(dependency).second )
+            frames.push_back({dependency, dependencies(dependency).begin()});
+    }
+    return false;
+}
+
+}} // namespace lv, el
+
+#endif // LVDEPENDENCYCYCLES_H
@@ -15,15 +15,35 @@
 
 #include "elementsmodule.h"
 #include "modulefile.h"
+#include "compilescheduler_p.h"
+#include "compilecache_p.h"
+#include "compilertrace_p.h"
+#include "modulebundle_p.h"
+#include "outputqueue_p.h"
+#include "languagenodes_p.h"
 #include "live/modulecontext.h"
 #include "live/exception.h"
 #include "live/fileio.h"
+#include "live/mlnodetojson.h"
 #include "live/path.h"
 #include "live/visuallog.h"
 #include "live/elements/compiler/tracepointexception.h"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
 namespace lv{ namespace el{
 
+namespace{
+
+const char* moduleInterfaceFileName = "module.interface.json";
+const char* moduleBundleFileName = "module.bundle.js";
+
+} // namespace
+
 /**
  * \class ElementsModule
  * \brief Container for module functionality on the Elements side.
@@ -32,18 +52,28 @@ namespace lv{ namespace el{
 class ElementsModulePrivate{
 public:
     ElementsModulePrivate(Engine* e)
-        : engine(e), typesResolved(false), isCompiled(false){}
+        : engine(e), typesResolved(false), reachabilityResolved(false), isCompiled(false), interfaceLoaded(false){}
 
     Module::Ptr   module;
     Compiler::Ptr compiler;
     Engine*       engine;
     std::map<std::string, ModuleFile*> fileModules;
+    std::unordered_map<std::string, ModuleFile*> fileModulesByPath;
     std::list<ModuleLibrary*>          libraries;
 
     std::map<std::string, ElementsModule::Export> exports;
+    /** Paths from this module to imported modules, by import id, see importPathPrefix() */
+    std::unordered_map<std::string, std::string> relativeImportPrefixes;
+    std::unordered_map<std::string, std::string> packageImportPrefixes;
+    /** Modules whose files import this one, they keep it alive through ModuleFile::Import */
+    std::set<ElementsModule*> importers;
 
     bool typesResolved;
+    bool reachabilityResolved;
+    /** Unreachable files whose size was added to the compiler's pruned bytes */
+    std::set<ModuleFile*> prunedFiles;
     bool isCompiled;
+    bool interfaceLoaded;
 };
 
 
@@ -56,6 +86,7 @@ ElementsModule::ElementsModule(Module::Ptr plugin, Compiler::Ptr compiler, Engin
 
 
 ElementsModule::~ElementsModule(){
+    unload();
 #ifdef BUILD_ELEMENTS_ENGINE
 //    for ( auto it = m_d->libraries.begin(); it != m_d->libraries.end(); ++it ){
 //        delete *it;
@@ -78,11 +109,245 @@ ElementsModule::Ptr ElementsModule::create(Module::Ptr module, Compiler::Ptr com
     return createImpl(module, compiler, nullptr);
 }
 
+/**
+ * \brief Creates the module from the interface summary written by a previous build, without parsing its files
+ *
+ * Returns nullptr if there is no summary, or if the module files, their content, the compiler
+ * configuration or the interface of an imported module changed since it was written.
+ */
+ElementsModule::Ptr ElementsModule::createFromInterface(Module::Ptr module, Compiler::Ptr compiler){
+    LV_COMPILER_TRACE_SPAN("loadModuleInterface", module->path());
+    std::string path = Path::join(compiler->moduleBuildPath(module), moduleInterfaceFileName);
+    if ( !Path::exists(path) )
+        return nullptr;
+
+    class FileInterface{
+    public:
+        std::string name;
+        std::list<ModuleFile::Export> exports;
+        std::list<ModuleFile::Import> imports;
+    };
+    std::list<FileInterface> files;
+
+    try{
+        MLNode summary;
+        ml::fromJson(compiler->fileIO()->readFromFile(path), summary);
+
+        if ( summary["config"].asString() != compiler->configHash() )
+            return nullptr;
+
+        const MLNode::ArrayType& filesNode = summary["files"].asArray();
+        if ( filesNode.size() != module->fileModules().size() )
+            return nullptr;
+
+        for ( const MLNode& fileNode : filesNode ){
+            FileInterface fi;
+            fi.name = fileNode["name"].asString();
+
+            std::string filePath = Path::join(module->path(), fi.name + ".lv");
+            if ( std::find(module->fileModules().begin(), module->fileModules().end(), fi.name) == module->fileModules().end() )
+                return nullptr;
+            if ( !Path::exists(filePath) || !Path::exists(Path::join(compiler->moduleBuildPath(module), fileNode["jsFileName"].asString())) )
+                return nullptr;
+            if ( CompileCache::hash(compiler->fileIO()->readFromFile(filePath)) != fileNode["content"].asString() )
+                return nullptr;
+
+            for ( const MLNode& exportNode : fileNode["exports"].asArray() ){
+                ModuleFile::Export expt;
+                expt.name = exportNode["name"].asString();
+                expt.type = exportNode["component"].asBool() ? ModuleFile::Export::Component : ModuleFile::Export::Element;
+                fi.exports.push_back(expt);
+            }
+
+            for ( const MLNode& importNode : fileNode["imports"].asArray() ){
+                ModuleFile::Import imp;
+                imp.uri = importNode["uri"].asString();
+                imp.as = importNode["as"].asString();
+                imp.isRelative = importNode["relative"].asBool();
+                imp.module = Compiler::compileImportedModule(compiler, importNode["module"].asString(), module, nullptr);
+                if ( !imp.module || imp.module->interfaceHash() != importNode["interface"].asString() )
+                    return nullptr;
+                fi.imports.push_back(imp);
+            }
+
+            files.push_back(fi);
+        }
+    } catch ( lv::Exception& ){
+        // unreadable summaries and failing imports are left to the full load to report
+        return nullptr;
+    }
+
+    ElementsModule::Ptr epl(new ElementsModule(module, compiler, nullptr));
+    for ( const FileInterface& fi : files ){
+        ModuleFile* mf = new ModuleFile(epl, fi.name + ".lv", "");
+        mf->setInterface(fi.exports, fi.imports);
+        epl->m_d->fileModules[mf->fileName()] = mf;
+
+        for ( auto it = fi.exports.begin(); it != fi.exports.end(); ++it ){
+            ElementsModule::Export exp;
+            exp.name = it->name;
+            exp.type = it->type == ModuleFile::Export::Element ? ElementsModule::Export::Element : ElementsModule::Export::Component;
+            exp.file = mf;
+            epl->m_d->exports.insert(std::make_pair(exp.name, exp));
+        }
+    }
+    epl->m_d->typesResolved = true;
+    epl->m_d->interfaceLoaded = true;
+
+    vlog("lvcompiler").v() << "Compiler: Loaded module interface: " << path;
+
+    return epl;
+}
+
+/**
+ * \brief Writes the interface summary of this module next to its build output
+ *
+ * The summary holds the exports and imports of each file, with the hashes needed to check it
+ * is still valid. Modules of released packages, modules that were loaded from their
+ * summary, and modules pruned from entry points are not written.
+ */
+void ElementsModule::writeInterface(){
+    if ( m_d->interfaceLoaded || m_d->fileModules.empty() || !m_d->compiler->config().fileOutputEnabled() || isPruning() )
+        return;
+    LV_COMPILER_TRACE_SPAN("writeInterface", m_d->module->path());
+    if ( m_d->module->context() && m_d->module->context()->package && !m_d->module->context()->package->release().empty() )
+        return;
+
+    MLNode filesNode(MLNode::Array);
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        ModuleFile* mf = it->second;
+
+        MLNode fileNode(MLNode::Object);
+        fileNode["name"] = mf->name();
+        fileNode["jsFileName"] = mf->jsFileName();
+        fileNode["content"] = mf->contentHash();
+
+        MLNode exportsNode(MLNode::Array);
+        for ( const ModuleFile::Export& e : mf->exports() ){
+            MLNode exportNode(MLNode::Object);
+            exportNode["name"] = e.name;
+            exportNode["component"] = e.type == ModuleFile::Export::Component;
+            exportsNode.append(exportNode);
+        }
+        fileNode["exports"] = exportsNode;
+
+        MLNode importsNode(MLNode::Array);
+        for ( const ModuleFile::Import& imp : mf->imports() ){
+            if ( !imp.module || !imp.module->module()->context() )
+                return;
+            MLNode importNode(MLNode::Object);
+            importNode["uri"] = imp.uri;
+            importNode["as"] = imp.as;
+            importNode["relative"] = imp.isRelative;
+            importNode["module"] = imp.module->module()->context()->importId.data();
+            importNode["interface"] = imp.module->interfaceHash();
+            importsNode.append(importNode);
+        }
+        fileNode["imports"] = importsNode;
+
+        filesNode.append(fileNode);
+    }
+
+    MLNode summary(MLNode::Object);
+    summary["config"] = m_d->compiler->configHash();
+    summary["files"] = filesNode;
+
+    std::string data;
+    ml::toJson(summary, data);
+    m_d->compiler->outputQueue()->write(Path::join(m_d->compiler->moduleBuildPath(m_d->module), moduleInterfaceFileName), data);
+}
+
+/**
+ * \brief Writes the output of all module files into a single es module, next to the separate files
+ *
+ * Files are added after the files they depend on, and the bundle exports the exports of every file.
+ */
+void ElementsModule::writeBundle(){
+    if ( m_d->interfaceLoaded || m_d->fileModules.empty() || !m_d->compiler->config().fileOutputEnabled() || !m_d->compiler->config().moduleBundleEnabled() )
+        return;
+    LV_COMPILER_TRACE_SPAN("writeBundle", m_d->module->path());
+    if ( m_d->module->context() && m_d->module->context()->package && !m_d->module->context()->package->release().empty() )
+        return;
+
+    std::vector<ModuleFile*> ordered;
+    std::set<ModuleFile*> visited;
+    std::function<void(ModuleFile*)> visit = [this, &ordered, &visited, &visit](ModuleFile* mf){
+        if ( !visited.insert(mf).second )
+            return;
+        for ( ModuleFile* dependency : mf->dependencies() ){
+            if ( dependency->module().get() == this )
+                visit(dependency);
+        }
+        ordered.push_back(mf);
+    };
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        if ( !isPruning() || it->second->isReachable() )
+            visit(it->second);
+    }
+    if ( ordered.empty() )
+        return;
+
+    ModuleBundle bundle;
+    for ( ModuleFile* mf : ordered ){
+        ModuleBundle::File file;
+        file.importPath = "./" + mf->jsFileName();
+        file.output = mf->takeCompiledOutput();
+        if ( file.output.empty() ){
+            // taken by a previous bundle, the file output is written by then
+            file.output = m_d->compiler->fileIO()->readFromFile(m_d->compiler->moduleFileBuildPath(m_d->module, mf->filePath()));
+        }
+        for ( const ModuleFile::Export& e : mf->exports() )
+            file.exports.push_back(e.name);
+        bundle.addFile(file);
+    }
+
+    m_d->compiler->outputQueue()->write(Path::join(m_d->compiler->moduleBuildPath(m_d->module), moduleBundleFileName), bundle.toString());
+}
+
+/**
+ * \brief Hash of the exported names, their kinds and the files they are written to
+ */
+std::string ElementsModule::interfaceHash() const{
+    std::string data;
+    for ( auto it = m_d->exports.begin(); it != m_d->exports.end(); ++it ){
+        data += it->first;
+        data += it->second.type == ElementsModule::Export::Component ? ":c:" : ":e:";
+        data += it->second.file ? it->second.file->jsFileName() : "";
+        data += "|";
+    }
+    return CompileCache::hash(data);
+}
+
 ElementsModule::Ptr ElementsModule::createImpl(Module::Ptr module, Compiler::Ptr compiler, Engine *engine){
+    LV_COMPILER_TRACE_SPAN("loadModule", module->path());
     ElementsModule::Ptr epl(new ElementsModule(module, compiler, engine));
 
-    for ( auto it = module->fileModules().begin(); it != module->fileModules().end(); ++it ){
-        ElementsModule::addModuleFile(epl, *it + ".lv");
+    size_t buildWorkers = compiler->config().buildWorkers();
+    if ( buildWorkers > 0 && module->fileModules().size() > 1 ){
+        // parse files concurrently, then register them in order
+        std::vector<std::string> names;
+        for ( auto it = module->fileModules().begin(); it != module->fileModules().end(); ++it ){
+            names.push_back(*it + ".lv");
+        }
+        // files are owned here until the module registers them, so the ones left after a
+        // failure are released
+        std::vector<std::unique_ptr<ModuleFile> > files(names.size());
+
+        CompileScheduler scheduler(buildWorkers);
+        for ( size_t i = 0; i < names.size(); ++i ){
+            scheduler.addTask([&epl, &names, &files, i](){
+                files[i].reset(ElementsModule::loadModuleFile(epl, names[i]));
+            });
+        }
+        scheduler.run();
+
+        for ( size_t i = 0; i < names.size(); ++i ){
+            ElementsModule::addModuleFile(epl, files[i].release());
+        }
+    } else {
+        for ( auto it = module->fileModules().begin(); it != module->fileModules().end(); ++it ){
+            ElementsModule::addModuleFile(epl, *it + ".lv");
+        }
     }
 
     epl->initializeLibraries(module->libraryModules());
@@ -110,6 +375,13 @@ ModuleFile *ElementsModule::addModuleFile(ElementsModule::Ptr &epl, const std::s
         return it->second;
     }
 
+    return addModuleFile(epl, loadModuleFile(epl, name));
+}
+
+/**
+ * \brief Reads the module file \p name and loads its interface, either from the compile cache or by parsing it
+ */
+ModuleFile *ElementsModule::loadModuleFile(const ElementsModule::Ptr &epl, const std::string &name){
     Compiler::Ptr compiler = epl->m_d->compiler;
 
     std::string filePath = Path::join(epl->module()->path(), name);
@@ -121,18 +393,22 @@ ModuleFile *ElementsModule::addModuleFile(ElementsModule::Ptr &epl, const std::s
         );
     }
     std::string content = compiler->fileIO()->readFromFile(filePath);
-    LanguageParser::AST* ast = compiler->parser()->parse(content);
 
-    std::string componentName = name;
-    size_t i = componentName.find(".lv");
-    if ( i != std::string::npos ){
-        componentName = name.substr(0, i);
+    ModuleFile* mf = new ModuleFile(epl, name, content);
+    try{
+        mf->load();
+    } catch ( ... ){
+        delete mf;
+        throw;
     }
+    return mf;
+}
 
-    ProgramNode* pn = compiler->parseProgramNodes(filePath, componentName, ast);
-
-    ModuleFile* mf = new ModuleFile(epl, name, content, pn);
+ModuleFile *ElementsModule::addModuleFile(ElementsModule::Ptr &epl, ModuleFile *mf){
+    std::string name = mf->fileName();
+    std::string filePath = mf->filePath();
     epl->m_d->fileModules[name] = mf;
+    epl->m_d->fileModulesByPath[filePath] = mf;
 
     auto mfExports = mf->exports();
 
@@ -144,12 +420,23 @@ ModuleFile *ElementsModule::addModuleFile(ElementsModule::Ptr &epl, const std::s
         epl->m_d->exports.insert(std::make_pair(exp.name, exp));
     }
 
-    std::string currentUriName = epl->module()->context()->importId.data() + "." + name;
+    resolveFileImports(epl, mf);
+    return mf;
+}
+
+/**
+ * \brief Compiles and resolves the modules imported by \p mf that are not resolved yet
+ */
+void ElementsModule::resolveFileImports(const ElementsModule::Ptr &epl, ModuleFile *mf){
+    const std::string& filePath = mf->filePath();
+    std::string currentUriName = epl->module()->context()->importId.data() + "." + mf->fileName();
 
     auto mfImports = mf->imports();
     for ( auto it = mfImports.begin(); it != mfImports.end(); ++it ){
 
         ModuleFile::Import& imp = *it;
+        if ( imp.module )
+            continue;
 
         if ( imp.isRelative ){
             if ( epl->module()->context()->package == nullptr ){
@@ -197,7 +484,6 @@ ModuleFile *ElementsModule::addModuleFile(ElementsModule::Ptr &epl, const std::s
             }
         }
     }
-    return mf;
 }
 
 ModuleFile *ElementsModule::findModuleFileByName(const std::string &name) const{
@@ -208,13 +494,17 @@ ModuleFile *ElementsModule::findModuleFileByName(const std::string &name) const{
     return nullptr;
 }
 
+/**
+ * \brief Finds the file at \p path, which is only resolved if it does not match a file path as given
+ */
 ModuleFile *ElementsModule::moduleFileBypath(const std::string &path) const{
-    std::string pathNormalized = Path::resolve(path);
-    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
-        ModuleFile* mf = it->second;
-        if ( mf->filePath() == pathNormalized )
-            return mf;
-    }
+    auto it = m_d->fileModulesByPath.find(path);
+    if ( it != m_d->fileModulesByPath.end() )
+        return it->second;
+
+    it = m_d->fileModulesByPath.find(Path::resolve(path));
+    if ( it != m_d->fileModulesByPath.end() )
+        return it->second;
     return nullptr;
 }
 
@@ -226,17 +516,25 @@ void ElementsModule::compile(){
     if ( m_d->isCompiled )
         return;
 
-    // resolve types
-    if ( !m_d->typesResolved ){
-        for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
-            it->second->resolveTypes();
-        }
-        m_d->typesResolved = true;
+    size_t buildWorkers = m_d->compiler->config().buildWorkers();
+    if ( buildWorkers > 0 ){
+        CompileScheduler scheduler(buildWorkers);
+        std::map<ElementsModule*, CompileScheduler::TaskId> scheduled;
+        scheduleCompile(scheduler, scheduled);
+        scheduler.run();
+        m_d->compiler->flushOutput();
+        return;
     }
 
+    resolveTypes();
+    if ( !m_d->reachabilityResolved )
+        resolveReachability({this});
+
     // compile dependencies
     for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
         ModuleFile* mf = it->second;
+        if ( isPruning() && !mf->isReachable() )
+            continue;
 
         auto mfImports = mf->imports();
         for ( auto mit = mfImports.begin(); mit != mfImports.end(); ++mit ){
@@ -248,21 +546,434 @@ void ElementsModule::compile(){
     }
 
     for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
-        it->second->compile();
+        ModuleFile* mf = it->second;
+        if ( isPruning() && !mf->isReachable() ){
+            pruneFile(mf);
+            continue;
+        }
+        mf->compile();
+    }
+
+    copyAssets();
+    writeInterface();
+    writeBundle();
+    m_d->compiler->flushOutput();
+    releaseCompiledFiles();
+
+    m_d->isCompiled = true;
+}
+
+void ElementsModule::resolveTypes(){
+    if ( m_d->typesResolved )
+        return;
+    std::vector<ModuleFile*> files;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        it->second->resolveTypes();
+        files.push_back(it->second);
     }
+    ModuleFile::assertNoCycles(files);
+    m_d->typesResolved = true;
+}
+
+/**
+ * \brief Path that the js file names of the \p imported module are appended to, when imported from this module
+ *
+ * Relative imports resolve from this module up to the package and down to the imported module.
+ * Other imports resolve from the build path of the imported package. Prefixes are computed once
+ * per imported module.
+ */
+const std::string &ElementsModule::importPathPrefix(ElementsModule *imported, bool isRelative){
+    const Utf8& importedId = imported->module()->context()->importId;
+    std::unordered_map<std::string, std::string>& prefixes = isRelative ? m_d->relativeImportPrefixes : m_d->packageImportPrefixes;
+    auto found = prefixes.find(importedId.data());
+    if ( found != prefixes.end() )
+        return found->second;
+
+    std::string prefix;
+    if ( isRelative ){
+        // this plugin to package
+        std::vector<Utf8> parts = Utf8(m_d->module->context()->importId).split(".");
+        if ( parts.size() > 0 ){
+            parts.erase(parts.begin());
+        }
+
+        std::string pluginToPackage = "";
+        if ( parts.size() > 0 ){
+            for ( size_t i = 0; i < parts.size(); ++i ){
+                if ( !pluginToPackage.empty() )
+                    pluginToPackage += '/';
+                pluginToPackage += "..";
+            }
+        } else {
+            pluginToPackage = ".";
+        }
+
+        // package to new plugin
+
+        std::vector<Utf8> packageToNewPluginParts = Utf8(importedId).split(".");
+        if ( packageToNewPluginParts.size() > 0 ){
+            packageToNewPluginParts.erase(packageToNewPluginParts.begin());
+        }
+        std::string packageToNewPlugin = Utf8::join(packageToNewPluginParts, "/").data();
+        if ( !packageToNewPlugin.empty() )
+            packageToNewPlugin += "/";
+
+        prefix = pluginToPackage + "/" + packageToNewPlugin;
+
+    } else {
+        std::vector<Utf8> packageToPlugin = importedId.split(".");
+        packageToPlugin.erase(packageToPlugin.begin());
+
+        std::string configPackageBuildPath = m_d->compiler->packageBuildPath();
+        std::string packageBuildPath =
+            imported->module()->context()->package->name() +
+            (configPackageBuildPath.empty() ? "" : "/" + configPackageBuildPath);
+        std::string packageToPluginStr = Utf8::join(packageToPlugin, "/").data();
+        prefix = packageBuildPath + (packageToPluginStr.empty() ? "" : "/" + packageToPluginStr) + "/";
+    }
+
+    return prefixes.emplace(importedId.data(), prefix).first->second;
+}
 
+/**
+ * \brief Marks the files reachable from the configured entry points
+ *
+ * Walks the \p roots and every module they import, starting from the entry point files and
+ * following the types each file uses, within its module and from imported modules. Only
+ * reachable files are compiled afterwards, so this runs once for all the modules of a compile
+ * call, before any of them is compiled. Files stay reachable once marked. Files of modules that
+ * were already compiled and become reachable are compiled here, and the bundles of their
+ * modules are written again.
+ */
+void ElementsModule::resolveReachability(const std::vector<ElementsModule*>& roots){
+    if ( roots.empty() || !roots.front()->isPruning() )
+        return;
+    LV_COMPILER_TRACE_SPAN("resolveReachability", roots.front()->m_d->module->path());
+
+    std::vector<ElementsModule*> modules;
+    std::set<ElementsModule*> visitedModules;
+    std::function<void(ElementsModule*)> collect = [&modules, &visitedModules, &collect](ElementsModule* em){
+        if ( !visitedModules.insert(em).second )
+            return;
+        em->resolveTypes();
+        modules.push_back(em);
+        for ( auto it = em->m_d->fileModules.begin(); it != em->m_d->fileModules.end(); ++it ){
+            for ( const ModuleFile::Import& imp : it->second->imports() ){
+                if ( imp.module )
+                    collect(imp.module.get());
+            }
+        }
+    };
+    for ( ElementsModule* root : roots )
+        collect(root);
+
+    const std::list<std::string>& entryPoints = roots.front()->m_d->compiler->config().entryPoints();
+    std::set<std::string> entryPaths;
+    for ( const std::string& entryPoint : entryPoints ){
+        entryPaths.insert(entryPoint);
+        entryPaths.insert(Path::resolve(entryPoint));
+    }
+
+    std::vector<ModuleFile*> queue;
+    for ( ElementsModule* em : modules ){
+        for ( auto it = em->m_d->fileModules.begin(); it != em->m_d->fileModules.end(); ++it ){
+            ModuleFile* mf = it->second;
+            if ( !mf->isReachable() && entryPaths.find(mf->filePath()) != entryPaths.end() ){
+                mf->setReachable(true);
+                queue.push_back(mf);
+            }
+        }
+    }
+
+    std::vector<ModuleFile*> reached = queue;
+    while ( !queue.empty() ){
+        ModuleFile* mf = queue.back();
+        queue.pop_back();
+        for ( ModuleFile* next : mf->dependencies() ){
+            if ( !next->isReachable() ){
+                next->setReachable(true);
+                queue.push_back(next);
+                reached.push_back(next);
+            }
+        }
+        for ( ModuleFile* next : mf->importedFiles() ){
+            if ( !next->isReachable() ){
+                next->setReachable(true);
+                queue.push_back(next);
+                reached.push_back(next);
+            }
+        }
+    }
+
+    for ( ElementsModule* em : modules ){
+        em->m_d->reachabilityResolved = true;
+    }
+
+    std::set<ElementsModule*> changedModules;
+    for ( ModuleFile* mf : reached ){
+        ElementsModule* em = mf->module().get();
+        if ( !em->m_d->isCompiled )
+            continue;
+        if ( em->m_d->prunedFiles.erase(mf) > 0 )
+            em->m_d->compiler->removePrunedFile(mf->filePath(), mf->content().size());
+        mf->compile();
+        changedModules.insert(em);
+    }
+    for ( ElementsModule* em : changedModules ){
+        em->m_d->compiler->flushOutput();
+        em->writeBundle();
+        em->m_d->compiler->flushOutput();
+    }
+}
+
+/**
+ * \brief Adds the size of the unreachable \p mf to the compiler's pruned bytes, once per file
+ */
+void ElementsModule::pruneFile(ModuleFile *mf){
+    if ( m_d->prunedFiles.insert(mf).second )
+        m_d->compiler->addPrunedFile(mf->filePath(), mf->content().size());
+}
+
+/**
+ * \brief Returns true if entry points are configured, in which case only reachable files are compiled
+ */
+bool ElementsModule::isPruning() const{
+    return !m_d->compiler->config().entryPoints().empty();
+}
+
+/**
+ * \brief Releases the syntax trees, nodes and sources of the compiled files, if configured
+ *
+ * Files keep what other modules resolve against, and are parsed again if they are needed.
+ */
+void ElementsModule::releaseCompiledFiles(){
+    if ( !m_d->compiler->config().releaseAfterCompileEnabled() )
+        return;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        ModuleFile* mf = it->second;
+        if ( isPruning() && !mf->isReachable() )
+            continue;
+        mf->release();
+    }
+}
+
+/**
+ * \brief Bytes held by the files of this module, as reported by ModuleFile::memorySize()
+ */
+size_t ElementsModule::memorySize() const{
+    size_t size = 0;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it )
+        size += it->second->memorySize();
+    return size;
+}
+
+std::set<ElementsModule *> ElementsModule::importedModules() const{
+    std::set<ElementsModule*> result;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        for ( const ModuleFile::Import& imp : it->second->imports() ){
+            if ( imp.module )
+                result.insert(imp.module.get());
+        }
+    }
+    return result;
+}
+
+/**
+ * \brief Modules with files that import this module
+ */
+const std::set<ElementsModule *> &ElementsModule::importers() const{
+    return m_d->importers;
+}
+
+/**
+ * \brief Replaces the exports of \p mf after its interface was collected again
+ *
+ * If the names or kinds exported by \p mf changed, the other files of this module and the
+ * files importing this module resolve their types again, and true is returned.
+ */
+bool ElementsModule::updateFileExports(ModuleFile *mf){
+    std::map<std::string, ElementsModule::Export::Type> current;
+    for ( const ModuleFile::Export& e : mf->exports() )
+        current[e.name] = e.type == ModuleFile::Export::Element ? ElementsModule::Export::Element : ElementsModule::Export::Component;
+
+    bool changed = false;
+    std::vector<std::string> removed;
+    for ( auto it = m_d->exports.begin(); it != m_d->exports.end(); ){
+        if ( it->second.file == mf ){
+            auto found = current.find(it->first);
+            if ( found == current.end() || found->second != it->second.type ){
+                removed.push_back(it->first);
+                it = m_d->exports.erase(it);
+                changed = true;
+                continue;
+            }
+        }
+        ++it;
+    }
+
+    for ( auto it = current.begin(); it != current.end(); ++it ){
+        if ( m_d->exports.find(it->first) == m_d->exports.end() ){
+            ElementsModule::Export exp;
+            exp.name = it->first;
+            exp.type = it->second;
+            exp.file = mf;
+            m_d->exports.insert(std::make_pair(exp.name, exp));
+            changed = true;
+        }
+    }
+
+    // a removed name may still be exported by another file
+    for ( const std::string& name : removed ){
+        if ( m_d->exports.find(name) != m_d->exports.end() )
+            continue;
+        for ( auto fit = m_d->fileModules.begin(); fit != m_d->fileModules.end(); ++fit ){
+            ModuleFile* file = fit->second;
+            auto found = std::find_if(file->exports().begin(), file->exports().end(), [&name](const ModuleFile::Export& e){ return e.name == name; });
+            if ( file != mf && found != file->exports().end() ){
+                ElementsModule::Export exp;
+                exp.name = name;
+                exp.type = found->type == ModuleFile::Export::Element ? ElementsModule::Export::Element : ElementsModule::Export::Component;
+                exp.file = file;
+                m_d->exports.insert(std::make_pair(exp.name, exp));
+                break;
+            }
+        }
+    }
+
+    if ( !changed )
+        return false;
+
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        if ( it->second != mf )
+            it->second->reresolveTypes();
+    }
+    for ( ElementsModule* importer : m_d->importers ){
+        for ( auto it = importer->m_d->fileModules.begin(); it != importer->m_d->fileModules.end(); ++it ){
+            const std::list<ModuleFile::Import>& imports = it->second->imports();
+            bool importsThis = std::find_if(imports.begin(), imports.end(), [this](const ModuleFile::Import& imp){ return imp.module.get() == this; }) != imports.end();
+            if ( importsThis )
+                it->second->reresolveTypes();
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Files of this module, in module order
+ */
+std::vector<ModuleFile *> ElementsModule::moduleFiles() const{
+    std::vector<ModuleFile*> files;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it )
+        files.push_back(it->second);
+    return files;
+}
+
+void ElementsModule::addImporter(ElementsModule *importer){
+    m_d->importers.insert(importer);
+}
+
+/**
+ * \brief Deletes the files of this module, releasing the modules they import
+ *
+ * Modules importing this one have to be unloaded as well, their files point into this module.
+ */
+void ElementsModule::unload(){
+    for ( ElementsModule* imported : importedModules() )
+        imported->m_d->importers.erase(this);
+
+    std::map<std::string, ModuleFile*> files;
+    files.swap(m_d->fileModules);
+    m_d->fileModulesByPath.clear();
+    m_d->prunedFiles.clear();
+    m_d->exports.clear();
+    m_d->typesResolved = false;
+    m_d->reachabilityResolved = false;
+    m_d->isCompiled = false;
+
+    for ( auto it = files.begin(); it != files.end(); ++it ){
+        delete it->second;
+    }
+}
+
+void ElementsModule::copyAssets(){
+    LV_COMPILER_TRACE_SPAN("copyAssets", m_d->module->path());
     auto assets = m_d->module->assets();
     std::string moduleBuildPath = m_d->compiler->moduleBuildPath(m_d->module);
 
     for ( auto it = assets.begin(); it != assets.end(); ++it ){
         std::string assetPath = Path::join(m_d->module->path(), *it);
         std::string resultPath = Path::join(moduleBuildPath, *it);
-        if (Path::exists(resultPath))
-            Path::remove(resultPath);
-        Path::copyFile(assetPath, resultPath, Path::OverwriteExisting);
+        if ( m_d->compiler->outputQueue() ){
+            m_d->compiler->outputQueue()->copyFile(assetPath, resultPath);
+        } else {
+            Path::copyFile(assetPath, resultPath, Path::OverwriteExisting);
+        }
     }
+}
 
-    m_d->isCompiled = true;
+/**
+ * \brief Adds the compilation of this module and of its imports to the \p scheduler
+ *
+ * Each module file becomes a task that runs after the files it depends on and after the
+ * modules it imports. Returns the task that completes the module (copying its assets).
+ * Type resolution happens here, on the calling thread, so tasks only convert and write.
+ */
+CompileScheduler::TaskId ElementsModule::scheduleCompile(CompileScheduler &scheduler, std::map<ElementsModule *, CompileScheduler::TaskId> &scheduled){
+    auto scheduledIt = scheduled.find(this);
+    if ( scheduledIt != scheduled.end() )
+        return scheduledIt->second;
+
+    if ( m_d->isCompiled ){
+        CompileScheduler::TaskId moduleTask = scheduler.addTask([](){});
+        scheduled[this] = moduleTask;
+        return moduleTask;
+    }
+
+    resolveTypes();
+    if ( !m_d->reachabilityResolved )
+        resolveReachability({this});
+
+    CompileScheduler::TaskId moduleTask = scheduler.addTask([this](){
+        copyAssets();
+        writeInterface();
+        writeBundle();
+        releaseCompiledFiles();
+        m_d->isCompiled = true;
+    });
+    scheduled[this] = moduleTask;
+
+    std::map<ModuleFile*, CompileScheduler::TaskId> fileTasks;
+    for ( auto it = m_d->fileModules.begin(); it != m_d->fileModules.end(); ++it ){
+        ModuleFile* mf = it->second;
+        if ( isPruning() && !mf->isReachable() ){
+            pruneFile(mf);
+            continue;
+        }
+        CompileScheduler::TaskId fileTask = scheduler.addTask([mf](){ mf->compile(); });
+        fileTasks[mf] = fileTask;
+        scheduler.addDependency(moduleTask, fileTask);
+    }
+
+    for ( auto it = fileTasks.begin(); it != fileTasks.end(); ++it ){
+        ModuleFile* mf = it->first;
+        CompileScheduler::TaskId fileTask = it->second;
+
+        for ( auto depIt = mf->dependencies().begin(); depIt != mf->dependencies().end(); ++depIt ){
+            auto foundTask = fileTasks.find(*depIt);
+            if ( foundTask != fileTasks.end() )
+                scheduler.addDependency(fileTask, foundTask->second);
+        }
+
+        auto mfImports = mf->imports();
+        for ( auto mit = mfImports.begin(); mit != mfImports.end(); ++mit ){
+            if ( mit->module == nullptr ){
+                THROW_EXCEPTION(lv::Exception, Utf8("Import not resolved \'%\' when compiling \'%\'").format(mit->uri, mf->filePath()), lv::Exception::toCode("~Import"));
+            }
+            scheduler.addDependency(fileTask, mit->module->scheduleCompile(scheduler, scheduled));
+        }
+    }
+
+    return moduleTask;
 }
 
 Compiler::Ptr ElementsModule::compiler() const{
@@ -21,18 +21,25 @@
 #include "live/module.h"
 
 #include <memory>
+#include <set>
+#include <vector>
 
 namespace lv{ namespace el{
 
 class Engine;
 class ModuleFile;
 class ModuleLibrary;
+class ProgramNode;
+class CompileScheduler;
 
 class ElementsModulePrivate;
 class LV_ELEMENTS_COMPILER_EXPORT ElementsModule{
 
     DISABLE_COPY(ElementsModule);
 
+    friend class Compiler;
+    friend class ModuleFile;
+
 public:
     typedef std::shared_ptr<ElementsModule> Ptr;
 
@@ -79,7 +86,29 @@ public:
 
 private:
     void initializeLibraries(const std::list<std::string>& libs);
-
+    static ModuleFile* loadModuleFile(const ElementsModule::Ptr& epl, const std::string& name);
+    static ModuleFile* addModuleFile(ElementsModule::Ptr& epl, ModuleFile* mf);
+    static void resolveFileImports(const ElementsModule::Ptr& epl, ModuleFile* mf);
+    bool updateFileExports(ModuleFile* mf);
+    std::vector<ModuleFile*> moduleFiles() const;
+    void resolveTypes();
+    const std::string& importPathPrefix(ElementsModule* imported, bool isRelative);
+    static void resolveReachability(const std::vector<ElementsModule*>& roots);
+    void pruneFile(ModuleFile* mf);
+    bool isPruning() const;
+    void releaseCompiledFiles();
+    size_t memorySize() const;
+    std::set<ElementsModule*> importedModules() const;
+    const std::set<ElementsModule*>& importers() const;
+    void addImporter(ElementsModule* importer);
+    void unload();
+    void copyAssets();
+    void writeInterface();
+    void writeBundle();
+    std::string interfaceHash() const;
+    size_t scheduleCompile(CompileScheduler& scheduler, std::map<ElementsModule*, size_t>& scheduled);
+
+    static ElementsModule::Ptr createFromInterface(Module::Ptr module, Compiler::Ptr compiler);
     static ElementsModule::Ptr createImpl(Module::Ptr module, Compiler::Ptr compiler, Engine* engine);
     ElementsModule(Module::Ptr module, Compiler::Ptr compiler, Engine* engine);
 
@@ -17,4 +17,61 @@
 
 namespace lv{ namespace el{
 
+/**
+ * \brief Copies \p size bytes of \p data to the buffer
+ */
+void OutputBuffer::append(const char *data, size_t size){
+    if ( size == 0 )
+        return;
+    char* copy = allocate(size);
+    std::memcpy(copy, data, size);
+    appendReference(copy, size);
+}
+
+/**
+ * \brief Adds a part that references \p data, which needs to outlive the buffer
+ */
+void OutputBuffer::appendReference(const char *data, size_t size){
+    if ( size == 0 )
+        return;
+    Span span;
+    span.data = data;
+    span.size = size;
+    m_parts.push_back(span);
+    m_size += size;
+}
+
+/**
+ * \brief Reserves \p size bytes owned by the buffer, to be filled and added through appendReference()
+ */
+char *OutputBuffer::allocate(size_t size){
+    if ( m_chunks.empty() || m_chunks.back().capacity - m_chunks.back().size < size ){
+        Chunk chunk;
+        chunk.capacity = ChunkSize;
+        if ( size > chunk.capacity )
+            chunk.capacity = size;
+        chunk.size = 0;
+        chunk.data.reset(new char[chunk.capacity]);
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    Chunk& chunk = m_chunks.back();
+    char* result = chunk.data.get() + chunk.size;
+    chunk.size += size;
+    return result;
+}
+
+void OutputBuffer::appendTo(std::string &result) const{
+    result.reserve(result.size() + m_size);
+    for ( const Span& span : m_parts ){
+        result.append(span.data, span.size);
+    }
+}
+
+std::string OutputBuffer::toString() const{
+    std::string result;
+    appendTo(result);
+    return result;
+}
+
 }} // namespace lv, el
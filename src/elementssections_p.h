@@ -17,6 +17,8 @@
 #define LVELEMENTSSECTIONS_H
 
 #include <vector>
+#include <memory>
+#include <cstring>
 #include "languageparser.h"
 #include "live/utf8.h"
 #include "live/visuallog.h"
@@ -26,6 +28,55 @@ namespace lv{ namespace el{
 class ElementsInsertion;
 class JSSection;
 
+/**
+ * \class OutputBuffer
+ * \brief Append-only buffer the sections are flattened into
+ *
+ * The buffer is a list of parts. Text that outlives the buffer, like the source and the
+ * content of the sections, is referenced. Other text is copied into chunks that are never
+ * reallocated. The text is copied once more when it is joined.
+ */
+class OutputBuffer{
+
+    DISABLE_COPY(OutputBuffer);
+
+public:
+    class Span{
+    public:
+        const char* data;
+        size_t      size;
+    };
+
+public:
+    OutputBuffer() : m_size(0){}
+
+    void append(const char* data, size_t size);
+    void append(const std::string& text){ append(text.data(), text.size()); }
+    void appendReference(const char* data, size_t size);
+    void appendReference(const std::string& text){ appendReference(text.data(), text.size()); }
+    char* allocate(size_t size);
+
+    const std::vector<Span>& parts() const{ return m_parts; }
+    size_t size() const{ return m_size; }
+
+    void appendTo(std::string& result) const;
+    std::string toString() const;
+
+private:
+    class Chunk{
+    public:
+        std::unique_ptr<char[]> data;
+        size_t                  capacity;
+        size_t                  size;
+    };
+
+    static const size_t ChunkSize = 4096;
+
+    std::vector<Span>  m_parts;
+    std::vector<Chunk> m_chunks;
+    size_t             m_size;
+};
+
 class InsertionSection{
 public:
     enum Type{
@@ -37,9 +88,9 @@ public:
 
     virtual ~InsertionSection(){}
     virtual std::string toString() const{return content + "\n";}
-    virtual void flatten(const std::string&, std::vector<std::string>& parts){
+    virtual void flatten(const std::string&, OutputBuffer& output){
         if ( content.size() > 0 )
-            parts.push_back(content);
+            output.appendReference(content);
     }
 
 protected:
@@ -60,7 +111,7 @@ public:
 
     virtual std::string toString() const;
 
-    virtual void flatten(const std::string& source, std::vector<std::string>& parts);
+    virtual void flatten(const std::string& source, OutputBuffer& output);
 };
 
 class ElementsInsertion : public InsertionSection{
@@ -71,7 +122,7 @@ public:
 
     ElementsInsertion(): InsertionSection(Elements){}
 
-    ElementsInsertion& operator<<(const std::string& content){
+    ElementsInsertion& operator<<(std::string_view content){
         if ( m_children.empty() ){
             InsertionSection* is = new InsertionSection;
             is->content = content;
@@ -86,15 +137,22 @@ public:
         return *this;
     }
 
+    ElementsInsertion& operator<<(const OutputBuffer& output){
+        if ( m_children.empty() || m_children[m_children.size() - 1]->type != Insertion )
+            m_children.push_back(new InsertionSection);
+        output.appendTo(m_children[m_children.size() - 1]->content);
+        return *this;
+    }
+
     ElementsInsertion& operator<<(JSSection* section){
         m_children.push_back(section);
         return *this;
     }
 
-    virtual void flatten(const std::string& source, std::vector<std::string>& parts){
+    virtual void flatten(const std::string& source, OutputBuffer& output){
         for ( auto it = m_children.begin(); it != m_children.end(); ++it ){
             InsertionSection* ei = *it;
-            ei->flatten(source, parts);
+            ei->flatten(source, output);
         }
     }
 
@@ -118,34 +176,47 @@ inline std::string JSSection::toString() const{
     return base;
 }
 
-inline void JSSection::flatten(const std::string &source, std::vector<std::string> &parts){
+inline void JSSection::flatten(const std::string &source, OutputBuffer &output){
     int lastSegmentStart = from;
     for ( auto it = m_children.begin(); it != m_children.end(); ++it ){
         ElementsInsertion* ei = *it;
         if ( ei->from > lastSegmentStart ){
-            std::string midJs = source.substr(lastSegmentStart, ei->from - lastSegmentStart);
+            const char* midJsStart = source.data() + lastSegmentStart;
+            const char* midJsEnd   = source.data() + ei->from;
+
             bool newLineFollows = false;
-            for ( auto chIt = midJs.rbegin(); chIt != midJs.rend(); ++chIt ){
-                if ( *chIt == '\n' ){
+            for ( const char* ch = midJsEnd; ch != midJsStart; --ch ){
+                if ( *(ch - 1) == '\n' ){
                     newLineFollows = true;
                     break;
                 }
-                if ( !Utf8::isSpace(*chIt) )
+                if ( !Utf8::isSpace(*(ch - 1)) )
                     break;
             }
-            Utf8::trim(midJs);
-            if ( midJs.size() > 0 ){
-                if ( newLineFollows )
-                    midJs += "\n";
-                parts.push_back(midJs);
+
+            while ( midJsStart != midJsEnd && Utf8::isSpace(*midJsStart) )
+                ++midJsStart;
+            while ( midJsEnd != midJsStart && Utf8::isSpace(*(midJsEnd - 1)) )
+                --midJsEnd;
+
+            size_t midJsSize = static_cast<size_t>(midJsEnd - midJsStart);
+            if ( midJsSize > 0 ){
+                if ( newLineFollows ){
+                    char* midJs = output.allocate(midJsSize + 1);
+                    std::memcpy(midJs, midJsStart, midJsSize);
+                    midJs[midJsSize] = '\n';
+                    output.appendReference(midJs, midJsSize + 1);
+                } else {
+                    output.appendReference(midJsStart, midJsSize);
+                }
             }
         }
-        ei->flatten(source, parts);
+        ei->flatten(source, output);
         lastSegmentStart = ei->to;
     }
 
     if ( lastSegmentStart < to ){
-        parts.push_back(source.substr(lastSegmentStart, to - lastSegmentStart));
+        output.appendReference(source.data() + lastSegmentStart, static_cast<size_t>(to - lastSegmentStart));
     }
 }
 
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+
+#include "jscompactor_p.h"
+
+#include <cstring>
+
+namespace lv{ namespace el{
+
+/**
+ * \brief Returns the compact form of \p js
+ */
+std::string JsCompactor::compact(std::string_view js){
+    JsCompactor compactor(js);
+    compactor.run();
+    return std::move(compactor.m_output);
+}
+
+JsCompactor::JsCompactor(std::string_view js)
+    : m_js(js)
+    , m_pos(0)
+    , m_pendingSpace(false)
+    , m_pendingNewLine(false)
+    , m_closedHead(false)
+{
+    m_output.reserve(js.size());
+}
+
+void JsCompactor::run(){
+    while ( m_pos < m_js.size() ){
+        char c = m_js[m_pos];
+        char next = m_pos + 1 < m_js.size() ? m_js[m_pos + 1] : '\0';
+
+        if ( c == '\n' ){
+            m_pendingNewLine = true;
+            ++m_pos;
+        } else if ( c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v' ){
+            m_pendingSpace = true;
+            ++m_pos;
+        } else if ( c == '/' && next == '/' ){
+            while ( m_pos < m_js.size() && m_js[m_pos] != '\n' )
+                ++m_pos;
+        } else if ( c == '/' && next == '*' ){
+            size_t end = m_js.find("*/", m_pos + 2);
+            end = end == std::string_view::npos ? m_js.size() : end + 2;
+            // a comment spanning lines still ends the statement before it
+            if ( m_js.substr(m_pos, end - m_pos).find('\n') != std::string_view::npos )
+                m_pendingNewLine = true;
+            else
+                m_pendingSpace = true;
+            m_pos = end;
+        } else if ( c == '\'' || c == '"' ){
+            flushSeparator(c);
+            copyString(c);
+        } else if ( c == '`' ){
+            flushSeparator(c);
+            m_output.push_back(c);
+            ++m_pos;
+            copyTemplateText();
+        } else if ( c == '/' && regexAllowed() ){
+            flushSeparator(c);
+            copyRegex();
+        } else if ( c == '}' && !m_templateDepths.empty() && m_templateDepths.back() == 0 ){
+            m_pendingSpace = false;
+            m_pendingNewLine = false;
+            m_templateDepths.pop_back();
+            m_output.push_back(c);
+            ++m_pos;
+            copyTemplateText();
+        } else {
+            flushSeparator(c);
+            if ( !m_templateDepths.empty() ){
+                if ( c == '{' )
+                    ++m_templateDepths.back();
+                else if ( c == '}' )
+                    --m_templateDepths.back();
+            }
+            if ( c == '(' ){
+                std::string_view word = lastWord();
+                m_parenHeads.push_back(word == "if" || word == "while" || word == "for" || word == "with");
+            } else if ( c == ')' && !m_parenHeads.empty() ){
+                m_closedHead = m_parenHeads.back();
+                m_parenHeads.pop_back();
+            }
+            m_output.push_back(c);
+            ++m_pos;
+        }
+    }
+}
+
+/**
+ * \brief Writes the whitespace skipped before \p next, if any of it is still required
+ *
+ * A line break is dropped only where it can't end a statement: after an opening bracket or a
+ * separator, or before a closing bracket.
+ */
+void JsCompactor::flushSeparator(char next){
+    if ( !m_pendingNewLine && !m_pendingSpace )
+        return;
+
+    if ( !m_output.empty() ){
+        char last = m_output.back();
+        bool lineJoins = std::strchr("{([,;:", last) != nullptr || std::strchr("})]", next) != nullptr;
+        if ( m_pendingNewLine && !lineJoins ){
+            m_output.push_back('\n');
+        } else if ( needsSpace(last, next) ){
+            m_output.push_back(' ');
+        }
+    }
+
+    m_pendingSpace = false;
+    m_pendingNewLine = false;
+}
+
+void JsCompactor::copyString(char quote){
+    m_output.push_back(m_js[m_pos++]);
+    while ( m_pos < m_js.size() ){
+        char c = m_js[m_pos++];
+        m_output.push_back(c);
+        if ( c == '\\' && m_pos < m_js.size() ){
+            m_output.push_back(m_js[m_pos++]);
+        } else if ( c == quote || c == '\n' ){
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Copies template text up to its closing backtick, or up to the start of a substitution
+ */
+void JsCompactor::copyTemplateText(){
+    while ( m_pos < m_js.size() ){
+        char c = m_js[m_pos++];
+        m_output.push_back(c);
+        if ( c == '\\' && m_pos < m_js.size() ){
+            m_output.push_back(m_js[m_pos++]);
+        } else if ( c == '`' ){
+            return;
+        } else if ( c == '$' && m_pos < m_js.size() && m_js[m_pos] == '{' ){
+            m_output.push_back(m_js[m_pos++]);
+            m_templateDepths.push_back(0);
+            return;
+        }
+    }
+}
+
+void JsCompactor::copyRegex(){
+    m_output.push_back(m_js[m_pos++]);
+    bool inClass = false;
+    while ( m_pos < m_js.size() ){
+        char c = m_js[m_pos];
+        if ( c == '\n' )
+            return;
+        m_output.push_back(c);
+        ++m_pos;
+        if ( c == '\\' && m_pos < m_js.size() ){
+            m_output.push_back(m_js[m_pos++]);
+        } else if ( c == '[' ){
+            inClass = true;
+        } else if ( c == ']' ){
+            inClass = false;
+        } else if ( c == '/' && !inClass ){
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Checks whether a slash at the current position starts a regular expression
+ *
+ * Ambiguous cases are treated as regular expressions, which are copied unchanged. After a
+ * closing parenthesis, a slash divides, unless the parenthesis ends the condition of an if,
+ * while, for or with, where a statement starts.
+ */
+bool JsCompactor::regexAllowed() const{
+    if ( m_output.empty() )
+        return true;
+
+    char last = m_output.back();
+    if ( last == ')' )
+        return m_closedHead;
+
+    if ( isIdentifierChar(last) ){
+        std::string_view word = lastWord();
+
+        static const char* keywords[] = {
+            "return", "typeof", "instanceof", "in", "of", "new", "delete", "void",
+            "throw", "case", "do", "else", "yield", "await"
+        };
+        for ( const char* keyword : keywords ){
+            if ( word == keyword )
+                return true;
+        }
+        return false;
+    }
+
+    return last != ']' && last != '\'' && last != '"' && last != '`';
+}
+
+/**
+ * \brief Returns the identifier or keyword the output ends with, if any
+ */
+std::string_view JsCompactor::lastWord() const{
+    size_t start = m_output.size();
+    while ( start > 0 && isIdentifierChar(m_output[start - 1]) )
+        --start;
+    return std::string_view(m_output.data() + start, m_output.size() - start);
+}
+
+bool JsCompactor::isIdentifierChar(char c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+            c == '_' || c == '$' || c == '\\' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool JsCompactor::needsSpace(char last, char next){
+    if ( isIdentifierChar(last) && isIdentifierChar(next) )
+        return true;
+    if ( last == next && (last == '+' || last == '-') )
+        return true;
+    if ( last == '/' && (next == '/' || next == '*') )
+        return true;
+    return last >= '0' && last <= '9' && next == '.';
+}
+
+}} // namespace lv, el
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVJSCOMPACTOR_H
+#define LVJSCOMPACTOR_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lv{ namespace el{
+
+/**
+ * \class JsCompactor
+ * \brief Removes comments, indentation and redundant whitespace from generated js
+ *
+ * Line breaks are kept wherever they could end a statement, since the generated code relies on
+ * automatic semicolon insertion. Strings, template literals and regular expressions are copied
+ * as they are.
+ */
+class JsCompactor{
+
+public:
+    static std::string compact(std::string_view js);
+
+private:
+    JsCompactor(std::string_view js);
+
+    void run();
+    void flushSeparator(char next);
+    void copyString(char quote);
+    void copyTemplateText();
+    void copyRegex();
+    bool regexAllowed() const;
+    std::string_view lastWord() const;
+
+    static bool isIdentifierChar(char c);
+    static bool needsSpace(char last, char next);
+
+    std::string_view  m_js;
+    size_t            m_pos;
+    std::string       m_output;
+    bool              m_pendingSpace;
+    bool              m_pendingNewLine;
+    /** Open braces inside each template substitution currently being copied */
+    std::vector<int>  m_templateDepths;
+    /** Open parentheses, marking the ones that hold the condition of if, while, for or with */
+    std::vector<bool> m_parenHeads;
+    /** Whether the last closed parenthesis ended such a condition */
+    bool              m_closedHead;
+};
+
+}} // namespace lv, el
+
+#endif // LVJSCOMPACTOR_H
@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "languagenodearena_p.h"
+
+namespace lv{ namespace el{
+
+namespace{
+
+const size_t firstBlockSize = 4 * 1024;
+const size_t maxBlockSize   = 1024 * 1024;
+
+} // namespace
+
+LanguageNodeArena::LanguageNodeArena()
+    : m_current(nullptr)
+    , m_end(nullptr)
+    , m_nextBlockSize(firstBlockSize)
+    , m_lastDestructor(nullptr)
+    , m_totalObjects(0)
+    , m_totalBytes(0)
+{
+}
+
+LanguageNodeArena::~LanguageNodeArena(){
+    clear();
+}
+
+/**
+ * \brief Destroys all objects created in this arena and releases its blocks
+ */
+void LanguageNodeArena::clear(){
+    Destructor* d = m_lastDestructor;
+    while ( d ){
+        Destructor* previous = d->previous;
+        d->destroy(d->object);
+        d = previous;
+    }
+    m_lastDestructor = nullptr;
+
+    for ( auto it = m_blocks.begin(); it != m_blocks.end(); ++it ){
+        ::operator delete(*it);
+    }
+    m_blocks.clear();
+
+    m_current       = nullptr;
+    m_end           = nullptr;
+    m_nextBlockSize = firstBlockSize;
+    m_totalObjects  = 0;
+    m_totalBytes    = 0;
+}
+
+void *LanguageNodeArena::allocateBlock(size_t size, size_t alignment){
+    size_t blockSize = m_nextBlockSize;
+    while ( blockSize < size + alignment )
+        blockSize *= 2;
+    if ( m_nextBlockSize < maxBlockSize )
+        m_nextBlockSize *= 2;
+
+    char* block = static_cast<char*>(::operator new(blockSize));
+    m_blocks.push_back(block);
+    m_current = block;
+    m_end = block + blockSize;
+
+    return allocate(size, alignment);
+}
+
+}} // namespace lv, el
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVLANGUAGENODEARENA_H
+#define LVLANGUAGENODEARENA_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+namespace lv{ namespace el{
+
+/**
+ * \class LanguageNodeArena
+ * \brief Monotonic allocator for the nodes of a single program tree.
+ *
+ * Objects are placed contiguously into growing blocks and are destroyed all at once, in
+ * reverse order of creation, when the arena is cleared or destroyed. Memory is never
+ * given back individually.
+ */
+class LanguageNodeArena{
+
+public:
+    /** \brief Allocator for containers stored in the arena. Falls back to the heap if no arena is set. */
+    template<typename T> class Allocator{
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        Allocator() : m_arena(nullptr){}
+        Allocator(LanguageNodeArena* arena) : m_arena(arena){}
+        template<typename U> Allocator(const Allocator<U>& other) : m_arena(other.arena()){}
+
+        T* allocate(size_t n){
+            if ( m_arena )
+                return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        void deallocate(T* p, size_t){
+            if ( !m_arena )
+                ::operator delete(p);
+        }
+
+        LanguageNodeArena* arena() const{ return m_arena; }
+
+        template<typename U> bool operator == (const Allocator<U>& other) const{ return m_arena == other.arena(); }
+        template<typename U> bool operator != (const Allocator<U>& other) const{ return m_arena != other.arena(); }
+
+    private:
+        LanguageNodeArena* m_arena;
+    };
+
+public:
+    LanguageNodeArena();
+    ~LanguageNodeArena();
+
+    void* allocate(size_t size, size_t alignment);
+    template<typename T, typename ...Args> T* create(Args&& ...args);
+
+    void clear();
+
+    size_t totalObjects() const{ return m_totalObjects; }
+    size_t totalBlocks() const{ return m_blocks.size(); }
+    size_t totalBytes() const{ return m_totalBytes; }
+
+private:
+    LanguageNodeArena(const LanguageNodeArena&) = delete;
+    LanguageNodeArena& operator = (const LanguageNodeArena&) = delete;
+
+    class Destructor{
+    public:
+        void*       object;
+        void        (*destroy)(void*);
+        Destructor* previous;
+    };
+
+    template<typename T> static void destroyObject(void* object){ static_cast<T*>(object)->~T(); }
+
+    void* allocateBlock(size_t size, size_t alignment);
+
+    std::vector<char*> m_blocks;
+    char*              m_current;
+    char*              m_end;
+    size_t             m_nextBlockSize;
+    Destructor*        m_lastDestructor;
+    size_t             m_totalObjects;
+    size_t             m_totalBytes;
+};
+
+inline void *LanguageNodeArena::allocate(size_t size, size_t alignment){
+    size_t padding = (alignment - reinterpret_cast<size_t>(m_current) % alignment) % alignment;
+    if ( m_current && padding + size <= static_cast<size_t>(m_end - m_current) ){
+        void* result = m_current + padding;
+        m_current += padding + size;
+        m_totalBytes += size;
+        return result;
+    }
+    return allocateBlock(size, alignment);
+}
+
+template<typename T, typename ...Args> T* LanguageNodeArena::create(Args&& ...args){
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if ( !std::is_trivially_destructible<T>::value ){
+        Destructor* d = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+        d->object   = object;
+        d->destroy  = &LanguageNodeArena::destroyObject<T>;
+        d->previous = m_lastDestructor;
+        m_lastDestructor = d;
+    }
+    ++m_totalObjects;
+    return object;
+}
+
+}} // namespace lv, el
+
+#endif // LVLANGUAGENODEARENA_H
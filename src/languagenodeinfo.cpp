@@ -1,5 +1,7 @@
 #include "languagenodeinfo_p.h"
 
+#include <atomic>
+
 namespace lv{ namespace el{
 
 LanguageNodeInfo::LanguageNodeInfo(const std::string &tn, int t)
@@ -9,7 +11,7 @@ LanguageNodeInfo::LanguageNodeInfo(const std::string &tn, int t)
 
 
 LanguageNodeInfo::ConstPtr LanguageNodeInfo::create(std::string name){
-    static int counter = 0;
+    static std::atomic<int> counter(0);
     if ( name.rfind("Node") == name.size() - 5 )
         name = name.substr(0, name.size() - 4);
     return ConstPtr(new LanguageNodeInfo(name, counter++));
@@ -22,6 +22,7 @@
 #include <vector>
 #include <algorithm>
 #include <set>
+#include <memory>
 #include <string.h>
 
 namespace lv{ namespace el{
@@ -34,7 +35,11 @@ std::string BaseNode::ConversionContext::baseComponentImport(BaseNode::Conversio
     return ctx ? ctx->baseComponentImportUri : "";
 }
 
-bool BaseNode::ConversionContext::isImplicitType(BaseNode::ConversionContext *ctx, const std::string &type){
+bool BaseNode::ConversionContext::isImplicitType(BaseNode::ConversionContext *ctx, std::string_view type){
+    // js globals with constant members are always available
+    if ( PropertyBindingContainer::isFrozenGlobal(type) )
+        return true;
+
     if ( !ctx ){
         if ( type == "Element" )
             return true;
@@ -59,20 +64,20 @@ bool BaseNode::ConversionContext::isImplicitType(BaseNode::ConversionContext *ct
 BaseNode::BaseNode(const TSNode &node, const LanguageNodeInfo::ConstPtr &ni)
     : m_parent(nullptr)
     , m_node(node)
-    , m_nodeInfo(ni)
+    , m_nodeInfo(ni.get())
 {}
 
+/**
+ * \brief Nodes are owned by the arena of their ProgramNode, children are released along with it.
+ */
 BaseNode::~BaseNode(){
-    for ( auto it = m_children.begin(); it != m_children.end(); ++it ){
-        delete *it;
-    }
 }
 
 BaseNode *BaseNode::visit(const std::string &filePath, const std::string &fileName, LanguageParser::AST *ast){
     TSTree* tree = reinterpret_cast<TSTree*>(ast);
     TSNode root_node = ts_tree_root_node(tree);
 
-    ProgramNode* node = new ProgramNode(root_node);
+    std::unique_ptr<ProgramNode> node(new ProgramNode(root_node));
     node->setFileName(fileName);
     node->setFilePath(filePath);
 
@@ -80,34 +85,28 @@ BaseNode *BaseNode::visit(const std::string &filePath, const std::string &fileNa
 
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(root_node, i);
-        visit(node, child);
+        visit(node.get(), child);
     }
 
-    return node;
+    return node.release();
 }
 
-bool BaseNode::checkIdentifierDeclared(const std::string& source, BaseNode *node, std::string id, ConversionContext *ctx){
+bool BaseNode::checkIdentifierDeclared(const std::string& source, BaseNode *node, std::string_view id, ConversionContext *ctx){
     if (id == "this" || id == "parent" || id == "import" )
         return true;
     if ( ConversionContext::isImplicitType(ctx, id) )
         return true;
+    return isDeclaredInScope(source, node, id);
+}
 
-    BaseNode* prog = nullptr;
+/**
+ * \brief Checks whether \p id is declared in the block of \p node or in any block around it
+ */
+bool BaseNode::isDeclaredInScope(const std::string &source, BaseNode *node, std::string_view id){
     while (node){
-        JsBlockNode* hasIds = dynamic_cast<JsBlockNode*>(node);
-
-        if (!node->parent()){
-            prog = node;
-        }
-
-        if (hasIds){
-            for (auto it = hasIds->m_declarations.begin(); it != hasIds->m_declarations.end(); ++it){
-                std::string declaredId = slice(source, *it);
-                if (declaredId == id){
-                    return true;
-                }
-            }
-        }
+        JsBlockNode* hasIds = node->toJsBlock();
+        if ( hasIds && hasIds->hasDeclaration(source, id) )
+            return true;
 
         node = node->parent();
     }
@@ -115,7 +114,21 @@ bool BaseNode::checkIdentifierDeclared(const std::string& source, BaseNode *node
     return false;
 }
 
-const std::vector<BaseNode *>& BaseNode::children() const{
+/**
+ * \brief Clears the caches kept against the source in \p root and all its descendants
+ *
+ * Called by the owner of the tree before it is converted against a source it was not
+ * converted against before.
+ */
+void BaseNode::clearTreeSourceCaches(BaseNode *root){
+    if ( !root )
+        return;
+    root->clearSourceCaches();
+    for ( BaseNode* child : root->children() )
+        clearTreeSourceCaches(child);
+}
+
+const BaseNode::NodeList& BaseNode::children() const{
     return m_children;
 }
 
@@ -169,12 +182,20 @@ std::string BaseNode::slice(const std::string &source, BaseNode *node){
     return slice(source, node->startByte(), node->endByte());
 }
 
+/**
+ * \brief Returns a view of the \p source range covered by \p node, without copying it
+ */
+std::string_view BaseNode::sliceView(const std::string &source, BaseNode *node){
+    return std::string_view(source).substr(node->startByte(), node->endByte() - node->startByte());
+}
+
 JsBlockNode* BaseNode::addToDeclarations(BaseNode *parent, IdentifierNode *idNode){
     BaseNode* p = parent;
     while (p){
-        JsBlockNode* jsbn = dynamic_cast<JsBlockNode*>(p);
+        JsBlockNode* jsbn = p->toJsBlock();
         if (jsbn){
             jsbn->m_declarations.push_back(idNode);
+            jsbn->m_isDeclarationIndexed = false;
             return jsbn;
             break;
         }
@@ -186,7 +207,7 @@ JsBlockNode* BaseNode::addToDeclarations(BaseNode *parent, IdentifierNode *idNod
 JsBlockNode *BaseNode::addUsedIdentifier(BaseNode *parent, IdentifierNode *idNode){
     BaseNode* p = parent;
     while (p){
-        JsBlockNode* jsbn = dynamic_cast<JsBlockNode*>(p);
+        JsBlockNode* jsbn = p->toJsBlock();
         if (jsbn){
             jsbn->m_usedIdentifiers.push_back(idNode);
             return jsbn;
@@ -236,7 +257,7 @@ void BaseNode::assertValid(BaseNode *from, const TSNode &node, const std::string
 }
 
 void BaseNode::assertError(BaseNode *from, const TSNode &node, const std::string &message){
-    if ( strcmp(ts_node_type(node), "ERROR") == 0 ){
+    if ( nodeSymbol(node) == LanguageSymbols::Error ){
         SyntaxException se = SyntaxException(
             "Syntax error: " + message,
             Exception::toCode("~Language"),
@@ -257,25 +278,29 @@ void BaseNode::throwError(BaseNode *from, const TSNode &node, const std::string
     throw se;
 }
 
-TSNode BaseNode::nodeChildByFieldName(const TSNode &node, const std::string &name){
-    return ts_node_child_by_field_name(node, name.c_str(), static_cast<uint32_t>(name.length()));
+TSNode BaseNode::nodeChildByField(const TSNode &node, LanguageSymbols::Field field){
+    return LanguageSymbols::elements().childByField(node, field);
+}
+
+LanguageSymbols::Symbol BaseNode::nodeSymbol(const TSNode &node){
+    return LanguageSymbols::elements().symbol(node);
 }
 
 std::vector<IdentifierNode *> BaseNode::fromNestedIdentifier(BaseNode *parent, const TSNode &node){
     std::vector<IdentifierNode *> result;
-    if ( strcmp(ts_node_type(node), "identifier") == 0 ){
-        result.push_back(new IdentifierNode(node));
-    } else if ( strcmp(ts_node_type(node), "nested_identifier") == 0 ){
+    if ( nodeSymbol(node) == LanguageSymbols::Identifier ){
+        result.push_back(create<IdentifierNode>(parent, node));
+    } else if ( nodeSymbol(node) == LanguageSymbols::NestedIdentifier ){
         uint32_t count = ts_node_child_count(node);
         for ( uint32_t i = 0; i < count; ++i ){
             TSNode child = ts_node_child(node, i);
             assertError(parent, child, "Expected identifier.");
-            if ( strcmp(ts_node_type(child), "identifier") == 0 ){
-                result.push_back(new IdentifierNode(child));
-            } else if ( strcmp(ts_node_type(child), "nested_identifier") == 0 ){
+            if ( nodeSymbol(child) == LanguageSymbols::Identifier ){
+                result.push_back(create<IdentifierNode>(parent, child));
+            } else if ( nodeSymbol(child) == LanguageSymbols::NestedIdentifier ){
                 auto nestedResult = fromNestedIdentifier(parent, child);
                 result.insert( result.end(), nestedResult.begin(), nestedResult.end() );
-            } else if ( (strcmp(ts_node_type(child), ".") != 0) ){
+            } else if ( (nodeSymbol(child) != LanguageSymbols::Dot) ){
                 throwError(parent, child, "Expected identifier.");
             }
         }
@@ -285,34 +310,34 @@ std::vector<IdentifierNode *> BaseNode::fromNestedIdentifier(BaseNode *parent, c
 }
 
 ParameterListNode *BaseNode::scanFormalParameters(BaseNode *parent, const TSNode& formalParameters){
-    ParameterListNode* result = new ParameterListNode(formalParameters);
+    ParameterListNode* result = create<ParameterListNode>(parent, formalParameters);
 
     uint32_t paramterCount = ts_node_child_count(formalParameters);
 
     for (uint32_t pc = 0; pc < paramterCount; ++pc){
         TSNode ftpc = ts_node_child(formalParameters, pc);
         assertError(parent, ftpc, "Function declaration not supported.");
-        if (strcmp(ts_node_type(ftpc), "identifier") == 0){
-            auto nameNode = new IdentifierNode(ftpc);
-            auto paramNode = new ParameterNode(ftpc, nameNode);
+        if (nodeSymbol(ftpc) == LanguageSymbols::Identifier){
+            auto nameNode = create<IdentifierNode>(parent, ftpc);
+            auto paramNode = create<ParameterNode>(parent, ftpc, nameNode);
             result->m_parameters.push_back(paramNode);
-        } else if ( strcmp(ts_node_type(ftpc), "required_parameter") == 0 ){
-            auto name = BaseNode::nodeChildByFieldName(ftpc, "pattern");
-            auto paramNode = new ParameterNode(ftpc, new IdentifierNode(name));
+        } else if ( nodeSymbol(ftpc) == LanguageSymbols::RequiredParameter ){
+            auto name = nodeChildByField(ftpc, LanguageSymbols::FieldPattern);
+            auto paramNode = create<ParameterNode>(parent, ftpc, create<IdentifierNode>(parent, name));
             
-            auto type = BaseNode::nodeChildByFieldName(ftpc, "type");
+            auto type = nodeChildByField(ftpc, LanguageSymbols::FieldType);
             if (!ts_node_is_null(type)) {
-                paramNode->m_type = new TypeNode(type);
+                paramNode->m_type = create<TypeNode>(parent, type);
             }
             result->m_parameters.push_back(paramNode);
-        } else if ( strcmp(ts_node_type(ftpc), "optional_parameter") == 0 ){
-            auto name = BaseNode::nodeChildByFieldName(ftpc, "pattern");
-            auto paramNode = new ParameterNode(ftpc, new IdentifierNode(name));
+        } else if ( nodeSymbol(ftpc) == LanguageSymbols::OptionalParameter ){
+            auto name = nodeChildByField(ftpc, LanguageSymbols::FieldPattern);
+            auto paramNode = create<ParameterNode>(parent, ftpc, create<IdentifierNode>(parent, name));
             paramNode->m_isOptional = true;
             
-            auto type = BaseNode::nodeChildByFieldName(ftpc, "type");
+            auto type = nodeChildByField(ftpc, LanguageSymbols::FieldType);
             if (!ts_node_is_null(type)) {
-                paramNode->m_type = new TypeNode(type);
+                paramNode->m_type = create<TypeNode>(parent, type);
             }
             result->m_parameters.push_back(paramNode);
         }
@@ -321,29 +346,29 @@ ParameterListNode *BaseNode::scanFormalParameters(BaseNode *parent, const TSNode
 }
 
 ParameterListNode *BaseNode::scanFormalTypeParameters(BaseNode *parent, const TSNode &parameters){
-    auto result = new ParameterListNode(parameters);
+    auto result = create<ParameterListNode>(parent, parameters);
     uint32_t parameterCount = ts_node_child_count(parameters);
 
     for (uint32_t pc = 0; pc < parameterCount; ++pc){
         TSNode ftpc = ts_node_child(parameters, pc);
         assertError(parent, ftpc, "Function parameter not declared property.");
-        if (strcmp(ts_node_type(ftpc), "formal_type_parameter") == 0){
+        if (nodeSymbol(ftpc) == LanguageSymbols::FormalTypeParameter){
 
             if ( ts_node_child_count(ftpc) > 0 ){
                 TSNode typeParameter = ts_node_child(ftpc, 0);
 
-                TSNode parameterName = BaseNode::nodeChildByFieldName(typeParameter, "name");
+                TSNode parameterName = nodeChildByField(typeParameter, LanguageSymbols::FieldName);
                 assertValid(parent, parameterName, "Parameter name is null.");
-                TSNode parameterType = BaseNode::nodeChildByFieldName(typeParameter, "type");
+                TSNode parameterType = nodeChildByField(typeParameter, LanguageSymbols::FieldType);
                 assertValid(parent, parameterType, "Parameter type is null.");
 
-                if ( strcmp(ts_node_type(typeParameter), "required_type_parameter") == 0 ){
+                if ( nodeSymbol(typeParameter) == LanguageSymbols::RequiredTypeParameter ){
                     result->m_parameters.push_back(
-                        new ParameterNode(typeParameter, new IdentifierNode(parameterName), new TypeNode(parameterType), false)
+                        create<ParameterNode>(parent, typeParameter, create<IdentifierNode>(parent, parameterName), create<TypeNode>(parent, parameterType), false)
                     );
-                } else if ( strcmp(ts_node_type(typeParameter), "optional_type_parameter") == 0){
+                } else if ( nodeSymbol(typeParameter) == LanguageSymbols::OptionalTypeParameter){
                     result->m_parameters.push_back(
-                        new ParameterNode(typeParameter, new IdentifierNode(parameterName), new TypeNode(parameterType), true)
+                        create<ParameterNode>(parent, typeParameter, create<IdentifierNode>(parent, parameterName), create<TypeNode>(parent, parameterType), true)
                     );
                 }
             }
@@ -357,6 +382,10 @@ void BaseNode::addChild(BaseNode *child){
     child->setParent(this);
 }
 
+void BaseNode::setArena(LanguageNodeArena *arena){
+    m_children = NodeList(NodeList::allocator_type(arena));
+}
+
 std::string BaseNode::astString() const{
     char* str = ts_node_string(m_node);
     std::string result(str);
@@ -381,98 +410,133 @@ std::string BaseNode::toString(int indent) const{
 }
 
 void BaseNode::visit(BaseNode *parent, const TSNode &node){
-    if ( strcmp(ts_node_type(node), "import_statement") == 0 ){
+    switch ( nodeSymbol(node) ){
+    case LanguageSymbols::ImportStatement:
         visitImport(parent, node);
-    } else if ( strcmp(ts_node_type(node), "js_import_statement") == 0 ){
+        break;
+    case LanguageSymbols::JsImportStatement:
         visitJsImport(parent, node);
-    } else if ( strcmp(ts_node_type(node), "identifier") == 0 ){
+        break;
+    case LanguageSymbols::Identifier:
+    case LanguageSymbols::This:
         visitIdentifier(parent, node);
-    } else if ( strcmp(ts_node_type(node), "constructor_definition") == 0 ){
+        break;
+    case LanguageSymbols::ConstructorDefinition:
         visitConstructorDefinition(parent, node);
-    } else if ( strcmp(ts_node_type(node), "property_identifier") == 0 ){
+        break;
+    case LanguageSymbols::PropertyIdentifier:
         visitPropertyIdentifier(parent, node);
-    } else if ( strcmp(ts_node_type(node), "this") == 0 ){
-        visitIdentifier(parent, node);
-    } else if ( strcmp(ts_node_type(node), "import_path") == 0 ){
+        break;
+    case LanguageSymbols::ImportPath:
         visitImportPath(parent, node);
-    } else if ( strcmp(ts_node_type(node), "component") == 0 ){
+        break;
+    case LanguageSymbols::Component:
+    case LanguageSymbols::ComponentDeclaration:
         visitComponentDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "component_declaration") == 0 ){
-        visitComponentDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "component_instance_statement") == 0 ){
+        break;
+    case LanguageSymbols::ComponentInstanceStatement:
         visitComponentInstanceStatement(parent, node);
-    } else if ( strcmp(ts_node_type(node), "new_component_expression") == 0 ){
-        visitNewComponentExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "nested_new_component_expression") == 0 ){
+        break;
+    case LanguageSymbols::NewComponentExpression:
+    case LanguageSymbols::NestedNewComponentExpression:
         visitNewComponentExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "arrow_function") == 0 ){
+        break;
+    case LanguageSymbols::ArrowFunction:
         visitArrowFunction(parent, node);
-    } else if ( strcmp(ts_node_type(node), "component_body") == 0 ){
-        visitComponentBody(parent, node);
-    } else if ( strcmp(ts_node_type(node), "new_component_body") == 0 ){
+        break;
+    case LanguageSymbols::ComponentBody:
+    case LanguageSymbols::NewComponentBody:
         visitComponentBody(parent, node);
-    } else if ( strcmp(ts_node_type(node), "class_declaration") == 0 ){
+        break;
+    case LanguageSymbols::ClassDeclaration:
         visitClassDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "property_declaration") == 0 ){
+        break;
+    case LanguageSymbols::PropertyDeclaration:
         visitPropertyDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "static_property_declaration") == 0 ){
+        break;
+    case LanguageSymbols::StaticPropertyDeclaration:
         visitStaticPropertyDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "member_expression") == 0 ){
+        break;
+    case LanguageSymbols::MemberExpression:
         visitMemberExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "subscript_expression") == 0 ){
+        break;
+    case LanguageSymbols::SubscriptExpression:
         visitSubscriptExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "identifier_property_assignment") == 0 ){
+        break;
+    case LanguageSymbols::IdentifierPropertyAssignment:
         visitIdentifierAssignment(parent, node);
-    } else if ( strcmp(ts_node_type(node), "property_assignment") == 0 ){
+        break;
+    case LanguageSymbols::PropertyAssignment:
         visitPropertyAssignment(parent, node);
-    } else if ( strcmp(ts_node_type(node), "event_declaration") == 0 ){
+        break;
+    case LanguageSymbols::EventDeclaration:
         visitEventDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "listener_declaration") == 0 ){
+        break;
+    case LanguageSymbols::ListenerDeclaration:
         visitListenerDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "method_definition") == 0 ){
+        break;
+    case LanguageSymbols::MethodDefinition:
         visitMethodDefinition(parent, node);
-    } else if ( strcmp(ts_node_type(node), "typed_method_declaration") == 0 ){
+        break;
+    case LanguageSymbols::TypedMethodDeclaration:
         visitTypedMethodDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "property_accessor_declaration") == 0 ){
+        break;
+    case LanguageSymbols::PropertyAccessorDeclaration:
         visitPropertyAccessorDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "function_declaration") == 0 ){
+        break;
+    case LanguageSymbols::FunctionDeclaration:
         visitFunctionDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "function") == 0 ){
+        break;
+    case LanguageSymbols::Function:
         visitFunction(parent, node);
-    } else if ( strcmp(ts_node_type(node), "number") == 0 ){
+        break;
+    case LanguageSymbols::Number:
         visitNumber(parent, node);
-    } else if ( strcmp(ts_node_type(node), "expression_statement") == 0 ){
+        break;
+    case LanguageSymbols::ExpressionStatement:
         visitExpressionStatement(parent, node);
-    } else if ( strcmp(ts_node_type(node), "assignment_expression") == 0 ){
+        break;
+    case LanguageSymbols::AssignmentExpression:
         visitAssignmentExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "call_expression") == 0 ){
+        break;
+    case LanguageSymbols::CallExpression:
         visitCallExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "new_tagged_component_expression") == 0 ){
+        break;
+    case LanguageSymbols::NewTaggedComponentExpression:
         visitNewTaggedComponentExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "tagged_type_string") == 0 ){
+        break;
+    case LanguageSymbols::TaggedTypeString:
         visitTaggedString(parent, node);
-    } else if ( strcmp(ts_node_type(node), "new_tripple_tagged_component_expression") == 0 ){
+        break;
+    case LanguageSymbols::NewTrippleTaggedComponentExpression:
         visitNewTrippleTaggedComponentExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "tripple_tagged_type_string") == 0 ){
+        break;
+    case LanguageSymbols::TrippleTaggedTypeString:
         visitTrippleTaggedString(parent, node);
-    } else if ( strcmp(ts_node_type(node), "variable_declaration") == 0 ){
+        break;
+    case LanguageSymbols::VariableDeclaration:
         visitVariableDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "lexical_declaration") == 0 ){
+        break;
+    case LanguageSymbols::LexicalDeclaration:
         visitLexicalDeclaration(parent, node);
-    } else if ( strcmp(ts_node_type(node), "array_pattern") == 0 ){
+        break;
+    case LanguageSymbols::ArrayPattern:
+    case LanguageSymbols::ObjectPattern:
         visitDestructuringPattern(parent, node);
-    } else if ( strcmp(ts_node_type(node), "object_pattern") == 0 ){
-        visitDestructuringPattern(parent, node);
-    } else if ( strcmp(ts_node_type(node), "new_expression") == 0 ){
+        break;
+    case LanguageSymbols::NewExpression:
         visitNewExpression(parent, node);
-    } else if ( strcmp(ts_node_type(node), "return_statement") == 0 ){
+        break;
+    case LanguageSymbols::ReturnStatement:
         visitReturnStatement(parent, node);
-    } else if ( strcmp(ts_node_type(node), "object") == 0 ){
+        break;
+    case LanguageSymbols::Object:
         visitObject(parent, node);
-    } else if ( strcmp(ts_node_type(node), "try_statement") == 0 ){
+        break;
+    case LanguageSymbols::TryStatement:
         visitTryCatchBlock(parent, node);
-    } else if ( strcmp(ts_node_type(node), "ERROR") == 0 ){
-        
+        break;
+    case LanguageSymbols::Error: {
         SyntaxException se = SyntaxException(
             "Syntax error",
             Exception::toCode("~Language"),
@@ -480,7 +544,8 @@ void BaseNode::visit(BaseNode *parent, const TSNode &node){
             SOURCE_TRACE()
         );
         throw se;
-    } else {
+    }
+    default:
         visitChildren(parent, node);
     }
 }
@@ -494,70 +559,70 @@ void BaseNode::visitChildren(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitImport(BaseNode *parent, const TSNode &node){
-    ImportNode* importNode = new ImportNode(node);
+    ImportNode* importNode = create<ImportNode>(parent, node);
     parent->addChild(importNode);
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "import_as" ) == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::ImportAs ){
             TSNode aliasChild = ts_node_child(child, 1);
-            IdentifierNode* in = new IdentifierNode(aliasChild);
+            IdentifierNode* in = create<IdentifierNode>(parent, aliasChild);
             importNode->m_importAs = in;
             importNode->addChild(in);
-        } else if ( strcmp(ts_node_type(child), "import_path") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::ImportPath ){
             visitImportPath(importNode, child);
         }
     }
 }
 
 void BaseNode::visitJsImport(BaseNode *parent, const TSNode &node){
-    JsImportNode* importNode = new JsImportNode(node);
+    JsImportNode* importNode = create<JsImportNode>(parent, node);
     parent->addChild(importNode);
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "identifier" ) == 0 ){
-            IdentifierNode* name = new IdentifierNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::Identifier ){
+            IdentifierNode* name = create<IdentifierNode>(parent, child);
             importNode->m_importNames.push_back(name);
             importNode->addChild(name);
             addToDeclarations(parent, name);
-        } else if ( strcmp(ts_node_type(child), "string" ) == 0 ){
-            StringNode* path = new StringNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::String ){
+            StringNode* path = create<StringNode>(parent, child);
             importNode->m_importPath = path;
             importNode->addChild(path);
-        } else if ( strcmp(ts_node_type(child), "{") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::OpenBrace ){
             importNode->setIsObjectImport(true);
-        } else if ( strcmp(ts_node_type(child), "}") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::CloseBrace ){
             importNode->setIsObjectImport(true);
         }
     }
 }
 
 void BaseNode::visitIdentifier(BaseNode *parent, const TSNode &node){
-    IdentifierNode* identifierNode = new IdentifierNode(node);
+    IdentifierNode* identifierNode = create<IdentifierNode>(parent, node);
     parent->addChild(identifierNode);
     addUsedIdentifier(parent, identifierNode);
     visitChildren(identifierNode, node);
 }
 
 void BaseNode::visitPropertyIdentifier(BaseNode *parent, const TSNode &node){
-    IdentifierNode* identifierNode = new IdentifierNode(node);
+    IdentifierNode* identifierNode = create<IdentifierNode>(parent, node);
     parent->addChild(identifierNode);
     visitChildren(identifierNode, node);
 }
 
 void BaseNode::visitImportPath(BaseNode *parent, const TSNode &node){
-    ImportPathNode* ipnode = new ImportPathNode(node);
+    ImportPathNode* ipnode = create<ImportPathNode>(parent, node);
     uint32_t count = ts_node_child_count(node);
 
-    TSNode n = ts_node_child_by_field_name(node, "relative", 8);
+    TSNode n = nodeChildByField(node, LanguageSymbols::FieldRelative);
     if ( !ts_node_is_null(n) )
         ipnode->m_isRelative = true;
 
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "import_path_segment") == 0 ){
-            ImportPathSegmentNode* in = new ImportPathSegmentNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::ImportPathSegment ){
+            ImportPathSegmentNode* in = create<ImportPathSegmentNode>(parent, child);
             ipnode->m_segments.push_back(in);
             ipnode->addChild(in);
         }
@@ -566,35 +631,35 @@ void BaseNode::visitImportPath(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitComponentDeclaration(BaseNode *parent, const TSNode &node){
-    ComponentDeclarationNode* enode = new ComponentDeclarationNode(node);
+    ComponentDeclarationNode* enode = create<ComponentDeclarationNode>(parent, node);
     parent->addChild(enode);
 
 
-    TSNode name = nodeChildByFieldName(node, "name");
+    TSNode name = nodeChildByField(node, LanguageSymbols::FieldName);
     if ( !ts_node_is_null(name) ){
-        enode->m_name = new IdentifierNode(name);
+        enode->m_name = create<IdentifierNode>(parent, name);
         enode->addChild(enode->m_name);
         addToDeclarations(parent, enode->m_name);
     }
 
-    TSNode heritage = nodeChildByFieldName(node, "heritage");
+    TSNode heritage = nodeChildByField(node, LanguageSymbols::FieldHeritage);
     if ( !ts_node_is_null(heritage) ){
-        if ( strcmp(ts_node_type(heritage), "component_heritage") == 0 ){
+        if ( nodeSymbol(heritage) == LanguageSymbols::ComponentHeritage ){
             uint32_t heritageCount = ts_node_child_count(heritage);
             for ( uint32_t j = 0; j < heritageCount; ++j ){
                 TSNode heritageSegment = ts_node_child(heritage, j);
-                if ( strcmp(ts_node_type(heritageSegment), "identifier" ) == 0 ){
-                    IdentifierNode* heritageSegmentNode = new IdentifierNode(heritageSegment);
+                if ( nodeSymbol(heritageSegment) == LanguageSymbols::Identifier ){
+                    IdentifierNode* heritageSegmentNode = create<IdentifierNode>(parent, heritageSegment);
                     enode->m_heritage.push_back(heritageSegmentNode);
                     enode->addChild(heritageSegmentNode);
                 }
             }
-        } else if ( strcmp(ts_node_type(heritage), "component_short_heritage") == 0 ){
+        } else if ( nodeSymbol(heritage) == LanguageSymbols::ComponentShortHeritage ){
             uint32_t heritageCount = ts_node_child_count(heritage);
             for ( uint32_t j = 0; j < heritageCount; ++j ){
                 TSNode heritageSegment = ts_node_child(heritage, j);
-                if ( strcmp(ts_node_type(heritageSegment), "identifier" ) == 0 ){
-                    IdentifierNode* heritageSegmentNode = new IdentifierNode(heritageSegment);
+                if ( nodeSymbol(heritageSegment) == LanguageSymbols::Identifier ){
+                    IdentifierNode* heritageSegmentNode = create<IdentifierNode>(parent, heritageSegment);
                     enode->m_heritage.push_back(heritageSegmentNode);
                     enode->addChild(heritageSegmentNode);
                 }
@@ -607,33 +672,33 @@ void BaseNode::visitComponentDeclaration(BaseNode *parent, const TSNode &node){
     }
 
 
-    TSNode identifier = nodeChildByFieldName(node, "id");
+    TSNode identifier = nodeChildByField(node, LanguageSymbols::FieldId);
     if ( !ts_node_is_null(identifier) ){
         if ( ts_node_named_child_count(identifier) > 0 ){
             TSNode idChild = ts_node_child(identifier, 1);
-            enode->m_id = new IdentifierNode(idChild);
+            enode->m_id = create<IdentifierNode>(parent, idChild);
             enode->addChild(enode->m_id);
             addToDeclarations(parent, enode->m_id);
         }
     }
 
-    TSNode body = nodeChildByFieldName(node, "body");
+    TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Component declaration body is null.");
-    enode->m_body = new ComponentBodyNode(body);
+    enode->m_body = create<ComponentBodyNode>(parent, body);
     enode->addChild(enode->m_body);
     visitChildren(enode->m_body, body);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "ERROR") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::Error ){
             assertError(enode, child, "Unexpected component syntax.");
         }
     }
 }
 
 void BaseNode::visitComponentBody(BaseNode *parent, const TSNode &node){
-    ComponentBodyNode* enode = new ComponentBodyNode(node);
+    ComponentBodyNode* enode = create<ComponentBodyNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 }
@@ -645,16 +710,16 @@ void BaseNode::visitNewComponentExpression(BaseNode *parent, const TSNode &node)
         && parent->parent()
         && parent->parent()->isNodeType<ProgramNode>() )
     {
-        enode = new RootNewComponentExpressionNode(node);
+        enode = create<RootNewComponentExpressionNode>(parent, node);
     } else {
         BaseNode* p = parent;
-        while (p && dynamic_cast<JsBlockNode*>(p) == nullptr){
+        while (p && p->toJsBlock() == nullptr){
             p = p->parent();
         }
         if (p && p->isNodeType<JsBlockNode>() ){
-            enode = new RootNewComponentExpressionNode(node);
+            enode = create<RootNewComponentExpressionNode>(parent, node);
         } else {
-            enode = new NewComponentExpressionNode(node);
+            enode = create<NewComponentExpressionNode>(parent, node);
         }
     }
 
@@ -662,25 +727,25 @@ void BaseNode::visitNewComponentExpression(BaseNode *parent, const TSNode &node)
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "identifier") == 0 ){
-            auto iden = new IdentifierNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::Identifier ){
+            auto iden = create<IdentifierNode>(parent, child);
             enode->m_name.push_back(iden);
             enode->addChild(iden);
             if ( enode->m_name.size() == 1 )
                 addUsedIdentifier(enode, iden);
-        } else if ( strcmp(ts_node_type(child), "nested_identifier") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::NestedIdentifier ){
             enode->m_name = BaseNode::fromNestedIdentifier(enode, child);
             for( IdentifierNode* name : enode->m_name )
                 enode->addChild(name);
             if ( enode->m_name.size() > 0 ){
                 addUsedIdentifier(enode, enode->m_name.front());
             }
-        } else if ( strcmp(ts_node_type(child), "new_component_body") == 0 ){
-            enode->m_body = new ComponentBodyNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::NewComponentBody ){
+            enode->m_body = create<ComponentBodyNode>(parent, child);
             enode->addChild(enode->m_body);
             visitChildren(enode->m_body, child);
-        } else if ( strcmp(ts_node_type(child), "arguments") == 0 ){
-            enode->m_arguments = new ArgumentsNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::Arguments ){
+            enode->m_arguments = create<ArgumentsNode>(parent, child);
             enode->addChild(enode->m_arguments);
             visitChildren(enode->m_arguments, child);
             for ( auto child : enode->m_arguments->children() ){
@@ -689,11 +754,11 @@ void BaseNode::visitNewComponentExpression(BaseNode *parent, const TSNode &node)
                 }
             }
 
-        } else if ( strcmp(ts_node_type(child), "component_identifier") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::ComponentIdentifier ){
             TSNode id = ts_node_child(child, 1);
-            if (strcmp(ts_node_type(id), "identifier") != 0)
+            if (nodeSymbol(id) != LanguageSymbols::Identifier)
                 continue;
-            enode->m_id = new IdentifierNode(id);
+            enode->m_id = create<IdentifierNode>(parent, id);
             enode->addChild(enode->m_id);
         }
     }
@@ -746,51 +811,51 @@ void BaseNode::visitNewComponentExpression(BaseNode *parent, const TSNode &node)
 }
 
 void BaseNode::visitComponentInstanceStatement(BaseNode *parent, const TSNode &node){
-    ComponentInstanceStatementNode* enode = new ComponentInstanceStatementNode(node);
+    ComponentInstanceStatementNode* enode = create<ComponentInstanceStatementNode>(parent, node);
     parent->addChild(enode);
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
         assertError(parent, child, "Unexpected token.");
-        if ( strcmp(ts_node_type(child), "component_instance") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::ComponentInstance ){
             TSNode id = ts_node_child(child, 1);
-            if (strcmp(ts_node_type(id), "identifier") != 0)
+            if (nodeSymbol(id) != LanguageSymbols::Identifier)
                 continue;
-            enode->m_name = new IdentifierNode(id);
+            enode->m_name = create<IdentifierNode>(parent, id);
             addToDeclarations(parent, enode->m_name);
             enode->addChild(enode->m_name);
-        } else if ( strcmp(ts_node_type(child), "new_component_expression") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::NewComponentExpression ){
             visitNewComponentExpression(enode, child);
         }
     }
 }
 
 void BaseNode::visitPropertyDeclaration(BaseNode *parent, const TSNode &node){
-    PropertyDeclarationNode* enode = new PropertyDeclarationNode(node);
+    PropertyDeclarationNode* enode = create<PropertyDeclarationNode>(parent, node);
     parent->addChild(enode);
 
-    TSNode propName = BaseNode::nodeChildByFieldName(node, "name");
+    TSNode propName = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, propName, "Property name is null.");
-    enode->m_name = new IdentifierNode(propName);
+    enode->m_name = create<IdentifierNode>(parent, propName);
     enode->addChild(enode->m_name);
-    TSNode propType = BaseNode::nodeChildByFieldName(node, "type");
+    TSNode propType = nodeChildByField(node, LanguageSymbols::FieldType);
     if ( !ts_node_is_null(propType) ){
-        enode->m_type = new TypeNode(propType);
+        enode->m_type = create<TypeNode>(parent, propType);
         enode->addChild(enode->m_type);
     }
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "property_assignment_expression") == 0 ){
-            enode->m_expression = new BindableExpressionNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::PropertyAssignmentExpression ){
+            enode->m_expression = create<BindableExpressionNode>(parent, child);
             enode->addChild(enode->m_expression);
             visitChildren(enode->m_expression, child);
-        } else if (strcmp(ts_node_type(child), "statement_block") == 0) {
-            enode->m_statementBlock = new JsBlockNode(child);
+        } else if (nodeSymbol(child) == LanguageSymbols::StatementBlock) {
+            enode->m_statementBlock = create<JsBlockNode>(parent, child);
             enode->addChild(enode->m_statementBlock);
             visitChildren(enode->m_statementBlock, child);
-        } else if ( strcmp(ts_node_type(child), "=") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::Equals ){
             enode->m_isBindingAssignment = false;
         }
     }
@@ -807,27 +872,27 @@ void BaseNode::visitPropertyDeclaration(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitStaticPropertyDeclaration(BaseNode *parent, const TSNode &node){
-    StaticPropertyDeclarationNode* enode = new StaticPropertyDeclarationNode(node);
+    StaticPropertyDeclarationNode* enode = create<StaticPropertyDeclarationNode>(parent, node);
     parent->addChild(enode);
 
-    TSNode propName = BaseNode::nodeChildByFieldName(node, "name");
+    TSNode propName = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, propName, "Property name is null.");
-    enode->m_name = new IdentifierNode(propName);
+    enode->m_name = create<IdentifierNode>(parent, propName);
     enode->addChild(enode->m_name);
-    TSNode propType = BaseNode::nodeChildByFieldName(node, "type");
+    TSNode propType = nodeChildByField(node, LanguageSymbols::FieldType);
     if ( !ts_node_is_null(propType) ){
-        enode->m_type = new TypeNode(propType);
+        enode->m_type = create<TypeNode>(parent, propType);
         enode->addChild(enode->m_type);
     }
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "property_expression_initializer" ) == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::PropertyExpressionInitializer ){
             uint32_t initCount = ts_node_child_count(child);
             if ( initCount == 2 ){
                 TSNode initChild = ts_node_child(child, 1);
-                enode->m_expression = new BindableExpressionNode(initChild);
+                enode->m_expression = create<BindableExpressionNode>(parent, initChild);
                 enode->addChild(enode->m_expression);
                 visitChildren(enode->m_expression, initChild);
             }
@@ -851,13 +916,13 @@ void BaseNode::visitStaticPropertyDeclaration(BaseNode *parent, const TSNode &no
 }
 
 void BaseNode::visitBindableExpression(BaseNode *parent, const TSNode &node){
-    BindableExpressionNode* enode = new BindableExpressionNode(node);
+    BindableExpressionNode* enode = create<BindableExpressionNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 }
 
 void BaseNode::visitMemberExpression(BaseNode *parent, const TSNode &node){
-    MemberExpressionNode* enode = new MemberExpressionNode(node);
+    MemberExpressionNode* enode = create<MemberExpressionNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 
@@ -865,8 +930,8 @@ void BaseNode::visitMemberExpression(BaseNode *parent, const TSNode &node){
     uint32_t count = ts_node_child_count(node);
     if ( count > 0 ){
         TSNode child = ts_node_child(node, 0);
-        if ( strcmp(ts_node_type(child), "import") == 0 ){
-            enode->m_children.insert(enode->m_children.begin(), new IdentifierNode(child));
+        if ( nodeSymbol(child) == LanguageSymbols::Import ){
+            enode->m_children.insert(enode->m_children.begin(), create<IdentifierNode>(parent, child));
         }
     }
 
@@ -920,17 +985,17 @@ void BaseNode::visitMemberExpression(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitSubscriptExpression(BaseNode *parent, const TSNode &node){
-    SubscriptExpressionNode* enode = new SubscriptExpressionNode(node);
+    SubscriptExpressionNode* enode = create<SubscriptExpressionNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 }
 
 void BaseNode::visitPropertyAssignment(BaseNode *parent, const TSNode &node){
-    PropertyAssignmentNode* enode = new PropertyAssignmentNode(node);
+    PropertyAssignmentNode* enode = create<PropertyAssignmentNode>(parent, node);
     parent->addChild(enode);
     uint32_t count = ts_node_child_count(node);
 
-    TSNode propertyName = BaseNode::nodeChildByFieldName(node, "name");
+    TSNode propertyName = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, propertyName, "Failed to find property name.");
 
     auto propertyIdentifiers = fromNestedIdentifier(enode, propertyName);
@@ -941,15 +1006,15 @@ void BaseNode::visitPropertyAssignment(BaseNode *parent, const TSNode &node){
 
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "property_assignment_expression") == 0 ){
-            enode->m_expression = new BindableExpressionNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::PropertyAssignmentExpression ){
+            enode->m_expression = create<BindableExpressionNode>(parent, child);
             enode->addChild(enode->m_expression);
             visitChildren(enode->m_expression, child);
-        } else if (strcmp(ts_node_type(child),"statement_block") == 0) {
-            enode->m_statementBlock = new JsBlockNode(child);
+        } else if (nodeSymbol(child) == LanguageSymbols::StatementBlock) {
+            enode->m_statementBlock = create<JsBlockNode>(parent, child);
             enode->addChild(enode->m_statementBlock);
             visitChildren(enode->m_statementBlock, child);
-        } else if ( strcmp(ts_node_type(child), "=") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::Equals ){
             enode->m_isBindingAssignment = false;
         }
     }
@@ -974,28 +1039,28 @@ void BaseNode::visitIdentifierAssignment(BaseNode *parent, const TSNode &node){
 
     if ( componentParent->isNodeType<ComponentDeclarationNode>() ){
         ComponentDeclarationNode* cdn = componentParent->as<ComponentDeclarationNode>();
-        cdn->m_id = new IdentifierNode(idChild);
+        cdn->m_id = create<IdentifierNode>(parent, idChild);
         // provide id to outside scope
         addToDeclarations(componentParent, cdn->m_id);
     } else if ( componentParent->isNodeType<NewComponentExpressionNode>() ||
                 componentParent->isNodeType<RootNewComponentExpressionNode>() )
     {
         NewComponentExpressionNode* ncen = componentParent->as<NewComponentExpressionNode>();
-        ncen->m_id = new IdentifierNode(idChild);
+        ncen->m_id = create<IdentifierNode>(parent, idChild);
         // provide id to outside scope
         addToDeclarations(componentParent, ncen->m_id);
     }
 }
 
 void BaseNode::visitEventDeclaration(BaseNode *parent, const TSNode &node){
-    EventDeclarationNode* enode = new EventDeclarationNode(node);
+    EventDeclarationNode* enode = create<EventDeclarationNode>(parent, node);
     parent->addChild(enode);
 
-    TSNode name = nodeChildByFieldName(node, "name");
+    TSNode name = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, name, "Function name is null.");
-    enode->m_name = new IdentifierNode(name);
+    enode->m_name = create<IdentifierNode>(parent, name);
 
-    TSNode parameters = nodeChildByFieldName(node, "parameters");
+    TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
     assertValid(parent, parameters, "Event parameters are null.");
 
     enode->m_parameters = BaseNode::scanFormalTypeParameters(parent, parameters);
@@ -1011,28 +1076,28 @@ void BaseNode::visitEventDeclaration(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitListenerDeclaration(BaseNode *parent, const TSNode &node){
-    ListenerDeclarationNode* enode = new ListenerDeclarationNode(node);
+    ListenerDeclarationNode* enode = create<ListenerDeclarationNode>(parent, node);
     parent->addChild(enode);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "property_identifier") == 0 ){
-            enode->m_name = new IdentifierNode(child);
-        } else if ( strcmp(ts_node_type(child), "formal_parameters") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::PropertyIdentifier ){
+            enode->m_name = create<IdentifierNode>(parent, child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::FormalParameters ){
             enode->m_parameters = scanFormalParameters(parent, child);
         }
     }
 
-    TSNode body = BaseNode::nodeChildByFieldName(node, "body");
+    TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Failed to find listener body.");
 
-    if ( strcmp(ts_node_type(body), "statement_block") == 0 ){
-        enode->m_body = new JsBlockNode(body);
+    if ( nodeSymbol(body) == LanguageSymbols::StatementBlock ){
+        enode->m_body = create<JsBlockNode>(parent, body);
         enode->addChild(enode->m_body);
         visitChildren(enode->m_body, body);
     } else {
-        enode->m_bodyExpression = new ExpressionNode(body);
+        enode->m_bodyExpression = create<ExpressionNode>(parent, body);
         enode->addChild(enode->m_bodyExpression);
         visitChildren(enode->m_bodyExpression, body);
     }
@@ -1058,18 +1123,18 @@ void BaseNode::visitListenerDeclaration(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitMethodDefinition(BaseNode *parent, const TSNode &node){
-    MethodDefinitionNode* enode = new MethodDefinitionNode(node);
+    MethodDefinitionNode* enode = create<MethodDefinitionNode>(parent, node);
     parent->addChild(enode);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "property_identifier") == 0 ){
-            enode->m_name = new IdentifierNode(child);
-        } else if ( strcmp(ts_node_type(child), "formal_parameters") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::PropertyIdentifier ){
+            enode->m_name = create<IdentifierNode>(parent, child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::FormalParameters ){
             enode->m_parameters = BaseNode::scanFormalParameters(parent, child);
-        } else if ( strcmp(ts_node_type(child), "statement_block") == 0 ){
-            enode->m_body = new JsBlockNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::StatementBlock ){
+            enode->m_body = create<JsBlockNode>(parent, child);
             enode->addChild(enode->m_body);
             visitChildren(enode->m_body, child);
         }
@@ -1077,23 +1142,23 @@ void BaseNode::visitMethodDefinition(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitTypedMethodDeclaration(BaseNode *parent, const TSNode &node){
-    TypedMethodDeclarationNode* enode = new TypedMethodDeclarationNode(node);
+    TypedMethodDeclarationNode* enode = create<TypedMethodDeclarationNode>(parent, node);
     parent->addChild(enode);
 
-    TSNode name = nodeChildByFieldName(node, "name");
+    TSNode name = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, name, "Function name is null.");
-    enode->m_name = new IdentifierNode(name);
+    enode->m_name = create<IdentifierNode>(parent, name);
 
-    TSNode parameters = nodeChildByFieldName(node, "parameters");
+    TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
     assertValid(parent, parameters, "Function parameters are null.");
 
     enode->m_parameters = BaseNode::scanFormalTypeParameters(parent, parameters);
     enode->addChild(enode->m_parameters);
 
-    TSNode body = nodeChildByFieldName(node, "body");
+    TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Function body is null.");
 
-    enode->m_body = new JsBlockNode(body);
+    enode->m_body = create<JsBlockNode>(parent, body);
     enode->addChild(enode->m_body);
     visitChildren(enode->m_body, body);
 
@@ -1101,9 +1166,9 @@ void BaseNode::visitTypedMethodDeclaration(BaseNode *parent, const TSNode &node)
     for ( uint32_t i = 0; i < count; ++i ){
 
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "static") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::Static ){
             enode->setStatic(true);
-        } else if ( strcmp(ts_node_type(child), "async") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::Async ){
             enode->setAsync(true);
         }
     }
@@ -1123,32 +1188,32 @@ void BaseNode::visitTypedMethodDeclaration(BaseNode *parent, const TSNode &node)
 }
 
 void BaseNode::visitPropertyAccessorDeclaration(BaseNode *parent, const TSNode &node){
-    PropertyAccessorDeclarationNode* enode = new PropertyAccessorDeclarationNode(node);
+    PropertyAccessorDeclarationNode* enode = create<PropertyAccessorDeclarationNode>(parent, node);
     parent->addChild(enode);
 
     uint32_t nodeCount = ts_node_child_count(node);
     for (uint32_t i = 0; i < nodeCount; ++i){
-        if (strcmp(ts_node_type(ts_node_child(node, i)), "get") == 0){
+        if (nodeSymbol(ts_node_child(node, i)) == LanguageSymbols::Get){
             enode->m_access = PropertyAccessorDeclarationNode::Getter;
-        } else if (strcmp(ts_node_type(ts_node_child(node, i)), "set") == 0){
+        } else if (nodeSymbol(ts_node_child(node, i)) == LanguageSymbols::Set){
             enode->m_access = PropertyAccessorDeclarationNode::Setter;
         }
     }
 
-    TSNode name = nodeChildByFieldName(node, "name");
+    TSNode name = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, name, "Accessor name is null.");
-    enode->m_name = new IdentifierNode(name);
+    enode->m_name = create<IdentifierNode>(parent, name);
 
     if ( enode->m_access == PropertyAccessorDeclarationNode::Setter ){
-        TSNode parameters = nodeChildByFieldName(node, "parameters");
+        TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
         assertValid(parent, parameters, "Set parameters are null.");
         enode->m_parameters = scanFormalTypeParameters(enode, parameters);
     }
 
-    TSNode body = nodeChildByFieldName(node, "body");
+    TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Accessor body is null.");
 
-    enode->m_body = new JsBlockNode(body);
+    enode->m_body = create<JsBlockNode>(parent, body);
     enode->addChild(enode->m_body);
     visitChildren(enode->m_body, body);
 
@@ -1165,63 +1230,63 @@ void BaseNode::visitPropertyAccessorDeclaration(BaseNode *parent, const TSNode &
 }
 
 void BaseNode::visitPublicFieldDeclaration(BaseNode *parent, const TSNode &node){
-    PublicFieldDeclarationNode* enode = new PublicFieldDeclarationNode(node);
+    PublicFieldDeclarationNode* enode = create<PublicFieldDeclarationNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 }
 
 void BaseNode::visitJsScope(BaseNode *parent, const TSNode &node){
-    JsBlockNode* enode = new JsBlockNode(node);
+    JsBlockNode* enode = create<JsBlockNode>(parent, node);
     parent->addChild(enode);
     visitChildren(enode, node);
 }
 
 void BaseNode::visitNumber(BaseNode *parent, const TSNode &node)
 {
-    NumberNode* nnode = new NumberNode(node);
+    NumberNode* nnode = create<NumberNode>(parent, node);
     parent->addChild(nnode);
 }
 
 void BaseNode::visitConstructorDefinition(BaseNode *parent, const TSNode &node)
 {
-    ConstructorDefinitionNode* cdnode = new ConstructorDefinitionNode(node);
+    ConstructorDefinitionNode* cdnode = create<ConstructorDefinitionNode>(parent, node);
     parent->addChild(cdnode);
     // visitChildren(cdnode, node);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "statement_block") == 0 ){
-            cdnode->m_body = new JsBlockNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::StatementBlock ){
+            cdnode->m_body = create<JsBlockNode>(parent, child);
             cdnode->addChild(cdnode->m_body);
             visitChildren(cdnode->m_body, child);
-        } else if ( strcmp(ts_node_type(child), "formal_type_parameters") == 0 ){
+        } else if ( nodeSymbol(child) == LanguageSymbols::FormalTypeParameters ){
             TSNode& parameters = child;
 
-            cdnode->m_parameters = new ParameterListNode(parameters);
+            cdnode->m_parameters = create<ParameterListNode>(parent, parameters);
             cdnode->addChild(cdnode->m_parameters);
             uint32_t parameterCount = ts_node_child_count(parameters);
 
             for (uint32_t pc = 0; pc < parameterCount; ++pc){
                 TSNode ftpc = ts_node_child(parameters, pc);
                 assertError(parent, ftpc, "Constructor parameter not declared properly.");
-                if (strcmp(ts_node_type(ftpc), "formal_type_parameter") == 0){
+                if (nodeSymbol(ftpc) == LanguageSymbols::FormalTypeParameter){
 
                     if ( ts_node_child_count(ftpc) > 0 ){
                         TSNode typeParameter = ts_node_child(ftpc, 0);
 
-                        TSNode parameterName = BaseNode::nodeChildByFieldName(typeParameter, "name");
+                        TSNode parameterName = nodeChildByField(typeParameter, LanguageSymbols::FieldName);
                         assertValid(cdnode, parameterName, "Parameter name is null.");
-                        TSNode parameterType = BaseNode::nodeChildByFieldName(typeParameter, "type");
+                        TSNode parameterType = nodeChildByField(typeParameter, LanguageSymbols::FieldType);
                         assertValid(cdnode, parameterType, "Parameter type is null.");
 
-                        if ( strcmp(ts_node_type(typeParameter), "required_type_parameter") == 0 ){
+                        if ( nodeSymbol(typeParameter) == LanguageSymbols::RequiredTypeParameter ){
                             cdnode->m_parameters->m_parameters.push_back(
-                                new ParameterNode(typeParameter, new IdentifierNode(parameterName), new TypeNode(parameterType), false)
+                                create<ParameterNode>(parent, typeParameter, create<IdentifierNode>(parent, parameterName), create<TypeNode>(parent, parameterType), false)
                             );
-                        } else if ( strcmp(ts_node_type(typeParameter), "optional_type_parameter") == 0){
+                        } else if ( nodeSymbol(typeParameter) == LanguageSymbols::OptionalTypeParameter){
                             cdnode->m_parameters->m_parameters.push_back(
-                                new ParameterNode(typeParameter, new IdentifierNode(parameterName), new TypeNode(parameterType), true)
+                                create<ParameterNode>(parent, typeParameter, create<IdentifierNode>(parent, parameterName), create<TypeNode>(parent, parameterType), true)
                             );
                         }
                     }
@@ -1244,27 +1309,27 @@ void BaseNode::visitConstructorDefinition(BaseNode *parent, const TSNode &node)
 
 void BaseNode::visitExpressionStatement(BaseNode *parent, const TSNode &node)
 {
-    ExpressionStatementNode* esnode = new ExpressionStatementNode(node);
+    ExpressionStatementNode* esnode = create<ExpressionStatementNode>(parent, node);
     parent->addChild(esnode);
     visitChildren(esnode, node);
 }
 
 void BaseNode::visitAssignmentExpression(BaseNode *parent, const TSNode &node){
-    AssignmentExpressionNode* esnode = new AssignmentExpressionNode(node);
+    AssignmentExpressionNode* esnode = create<AssignmentExpressionNode>(parent, node);
     parent->addChild(esnode);
     visitChildren(esnode, node);
 }
 
 void BaseNode::visitCallExpression(BaseNode *parent, const TSNode &node)
 {
-    CallExpressionNode* enode = new CallExpressionNode(node);
+    CallExpressionNode* enode = create<CallExpressionNode>(parent, node);
     parent->addChild(enode);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "arguments") == 0 ){
-            enode->m_arguments = new ArgumentsNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::Arguments ){
+            enode->m_arguments = create<ArgumentsNode>(parent, child);
             enode->addChild(enode->m_arguments);
             visitChildren(enode->m_arguments, child);
 
@@ -1274,7 +1339,7 @@ void BaseNode::visitCallExpression(BaseNode *parent, const TSNode &node)
                 }
             }
 
-        } else if ( strcmp(ts_node_type(child), "super") == 0 ) {
+        } else if ( nodeSymbol(child) == LanguageSymbols::Super ) {
             enode->isSuper = true;
             if (parent->parent() && parent->parent()->parent()
                     && parent->parent()->parent()->isNodeType<ConstructorDefinitionNode>() )
@@ -1289,7 +1354,7 @@ void BaseNode::visitCallExpression(BaseNode *parent, const TSNode &node)
 
 void BaseNode::visitNewTaggedComponentExpression(BaseNode *parent, const TSNode &node)
 {
-    NewTaggedComponentExpressionNode* tagnode = new NewTaggedComponentExpressionNode(node);
+    NewTaggedComponentExpressionNode* tagnode = create<NewTaggedComponentExpressionNode>(parent, node);
     parent->addChild(tagnode);
     visitChildren(tagnode, node);
 
@@ -1320,7 +1385,7 @@ void BaseNode::visitNewTaggedComponentExpression(BaseNode *parent, const TSNode
 }
 
 void BaseNode::visitNewTrippleTaggedComponentExpression(BaseNode *parent, const TSNode &node){
-    NewTrippleTaggedComponentExpressionNode* tagnode = new NewTrippleTaggedComponentExpressionNode(node);
+    NewTrippleTaggedComponentExpressionNode* tagnode = create<NewTrippleTaggedComponentExpressionNode>(parent, node);
     parent->addChild(tagnode);
     visitChildren(tagnode, node);
 
@@ -1350,35 +1415,35 @@ void BaseNode::visitNewTrippleTaggedComponentExpression(BaseNode *parent, const
 }
 
 void BaseNode::visitTaggedString(BaseNode *parent, const TSNode &node){
-    TaggedStringNode* tsnode = new TaggedStringNode(node);
+    TaggedStringNode* tsnode = create<TaggedStringNode>(parent, node);
     parent->addChild(tsnode);
 }
 
 void BaseNode::visitTrippleTaggedString(BaseNode *parent, const TSNode &node){
-    TrippleTaggedStringNode* tsnode = new TrippleTaggedStringNode(node);
+    TrippleTaggedStringNode* tsnode = create<TrippleTaggedStringNode>(parent, node);
     parent->addChild(tsnode);
 }
 
 void BaseNode::visitFunction(BaseNode *parent, const TSNode &node){
-    FunctionNode* enode = new FunctionNode(node);
+    FunctionNode* enode = create<FunctionNode>(parent, node);
     parent->addChild(enode);
 
     // Function parameters
-    const TSNode parameters = BaseNode::nodeChildByFieldName(node, "parameters");
+    const TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
     assertValid(parent, parameters, "Function parameters are null.");
     enode->m_parameters = BaseNode::scanFormalParameters(parent, parameters);
 
     // Function return type
-    const TSNode returnType = BaseNode::nodeChildByFieldName(node, "return_type");
+    const TSNode returnType = nodeChildByField(node, LanguageSymbols::FieldReturnType);
     if (!ts_node_is_null(returnType)) {
-        enode->m_returnType = new TypeNode(returnType);
+        enode->m_returnType = create<TypeNode>(parent, returnType);
         enode->addChild(enode->m_returnType);
     }
 
     // Function body
-    const TSNode body = BaseNode::nodeChildByFieldName(node, "body");
+    const TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Function body is null.");
-    enode->m_body = new JsBlockNode(body);
+    enode->m_body = create<JsBlockNode>(parent, body);
     enode->addChild(enode->m_body);
     visitChildren(enode->m_body, body);
     
@@ -1386,7 +1451,7 @@ void BaseNode::visitFunction(BaseNode *parent, const TSNode &node){
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "async") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::Async ){
             enode->m_async = true;
         }
     }
@@ -1402,25 +1467,25 @@ void BaseNode::visitFunction(BaseNode *parent, const TSNode &node){
 
 void BaseNode::visitFunctionDeclaration(BaseNode *parent, const TSNode &node)
 {
-    FunctionDeclarationNode* enode = new FunctionDeclarationNode(node);
+    FunctionDeclarationNode* enode = create<FunctionDeclarationNode>(parent, node);
     parent->addChild(enode);
 
     // Function name
-    const TSNode name = BaseNode::nodeChildByFieldName(node, "name");
+    const TSNode name = nodeChildByField(node, LanguageSymbols::FieldName);
     assertValid(parent, name, "Function name is null.");
-    enode->m_name = new IdentifierNode(name);
+    enode->m_name = create<IdentifierNode>(parent, name);
     enode->addChild(enode->m_name);
     addToDeclarations(parent, enode->m_name);
 
     // Function parameters
-    const TSNode parameters = BaseNode::nodeChildByFieldName(node, "parameters");
+    const TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
     assertValid(parent, parameters, "Function parameters are null.");
     enode->m_parameters = BaseNode::scanFormalParameters(parent, parameters);
 
     // Function return type
-    const TSNode returnType = BaseNode::nodeChildByFieldName(node, "return_type");
+    const TSNode returnType = nodeChildByField(node, LanguageSymbols::FieldReturnType);
     if (!ts_node_is_null(returnType)) {
-        enode->m_returnType = new TypeNode(returnType);
+        enode->m_returnType = create<TypeNode>(parent, returnType);
         enode->addChild(enode->m_returnType);
     }
 
@@ -1428,15 +1493,15 @@ void BaseNode::visitFunctionDeclaration(BaseNode *parent, const TSNode &node)
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "async") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::Async ){
             enode->m_async = true;
         }
     }
 
     // Function body
-    const TSNode body = BaseNode::nodeChildByFieldName(node, "body");
+    const TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     assertValid(parent, body, "Function body is null.");
-    enode->m_body = new JsBlockNode(body);
+    enode->m_body = create<JsBlockNode>(parent, body);
     enode->addChild(enode->m_body);
     visitChildren(enode->m_body, body);
 
@@ -1451,13 +1516,13 @@ void BaseNode::visitFunctionDeclaration(BaseNode *parent, const TSNode &node)
 
 void BaseNode::visitClassDeclaration(BaseNode *parent, const TSNode &node)
 {
-    ClassDeclarationNode* fnode = new ClassDeclarationNode(node);
+    ClassDeclarationNode* fnode = create<ClassDeclarationNode>(parent, node);
     parent->addChild(fnode);
     visitChildren(fnode, node);
 
-    TSNode nameNode = ts_node_child_by_field_name(node, "name", 4);
-    if ( !ts_node_is_null(nameNode) && strcmp(ts_node_type(nameNode), "identifier") != 0){
-        fnode->addChild(new IdentifierNode(nameNode));
+    TSNode nameNode = nodeChildByField(node, LanguageSymbols::FieldName);
+    if ( !ts_node_is_null(nameNode) && nodeSymbol(nameNode) != LanguageSymbols::Identifier){
+        fnode->addChild(create<IdentifierNode>(parent, nameNode));
     }
 
     for (auto it = fnode->children().begin(); it != fnode->children().end(); ++it)
@@ -1474,9 +1539,9 @@ void BaseNode::visitVariableDeclaration(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitLexicalDeclaration(BaseNode *parent, const TSNode &node){
-    TSNode kind = BaseNode::nodeChildByFieldName(node, "kind");
+    TSNode kind = nodeChildByField(node, LanguageSymbols::FieldKind);
     VariableDeclarationNode::DeclarationForm mode = VariableDeclarationNode::Let;
-    if (!ts_node_is_null(kind) && strcmp(ts_node_type(kind), "const") == 0) {
+    if (!ts_node_is_null(kind) && nodeSymbol(kind) == LanguageSymbols::Const) {
         mode = VariableDeclarationNode::Const;
     }
 
@@ -1485,36 +1550,36 @@ void BaseNode::visitLexicalDeclaration(BaseNode *parent, const TSNode &node){
 
 
 void BaseNode::visitDeclarationForm(BaseNode * parent, const TSNode & node, int form){
-    VariableDeclarationNode* vdn = new VariableDeclarationNode(node);
+    VariableDeclarationNode* vdn = create<VariableDeclarationNode>(parent, node);
     vdn->m_declarationForm = static_cast<VariableDeclarationNode::DeclarationForm>(form);
     parent->addChild(vdn);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "variable_declarator") == 0 ){
-            VariableDeclaratorNode* declaratorNode = new VariableDeclaratorNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::VariableDeclarator ){
+            VariableDeclaratorNode* declaratorNode = create<VariableDeclaratorNode>(parent, child);
             declaratorNode->setParent(vdn);
             vdn->addChild(declaratorNode);
             vdn->m_declarators.push_back(declaratorNode);
             
-            TSNode name = BaseNode::nodeChildByFieldName(child, "name");
-            TSNode type = BaseNode::nodeChildByFieldName(child, "type");
-            TSNode value = BaseNode::nodeChildByFieldName(child, "value");
+            TSNode name = nodeChildByField(child, LanguageSymbols::FieldName);
+            TSNode type = nodeChildByField(child, LanguageSymbols::FieldType);
+            TSNode value = nodeChildByField(child, LanguageSymbols::FieldValue);
 
-            declaratorNode->m_name = new IdentifierNode(name);
+            declaratorNode->m_name = create<IdentifierNode>(parent, name);
             declaratorNode->addChild(declaratorNode->m_name);
             addToDeclarations(declaratorNode, declaratorNode->m_name);
             if (!ts_node_is_null(type)) {
-                declaratorNode->m_type = new TypeNode(type);
+                declaratorNode->m_type = create<TypeNode>(parent, type);
                 declaratorNode->addChild(declaratorNode->m_type);
             }
             if (!ts_node_is_null(value)) {
-                declaratorNode->m_value = new ExpressionNode(value);
+                declaratorNode->m_value = create<ExpressionNode>(parent, value);
                 declaratorNode->addChild(declaratorNode->m_value);
                 visit(declaratorNode->m_value, value);
             }
-        } else if ( strcmp(ts_node_type(child), ";") == 0 ) {
+        } else if ( nodeSymbol(child) == LanguageSymbols::Semicolon ) {
             vdn->m_hasSemicolon = true;
         } else {
             visit(vdn, child);
@@ -1527,13 +1592,13 @@ void BaseNode::visitDestructuringPattern(BaseNode *parent, const TSNode &node){
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "identifier") == 0 ){
-            auto inode = new IdentifierNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::Identifier ){
+            auto inode = create<IdentifierNode>(parent, child);
             inode->setParent(parent);
             parent->addChild(inode);
             addToDeclarations(parent, inode);
-        } else if ( strcmp(ts_node_type(child), "shorthand_property_identifier") == 0 ){
-            auto inode = new IdentifierNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::ShorthandPropertyIdentifier ){
+            auto inode = create<IdentifierNode>(parent, child);
             inode->setParent(parent);
             parent->addChild(inode);
             addToDeclarations(parent, inode);
@@ -1545,14 +1610,14 @@ void BaseNode::visitDestructuringPattern(BaseNode *parent, const TSNode &node){
 
 void BaseNode::visitNewExpression(BaseNode *parent, const TSNode &node)
 {
-    NewExpressionNode* nenode = new NewExpressionNode(node);
+    NewExpressionNode* nenode = create<NewExpressionNode>(parent, node);
     parent->addChild(nenode);
     nenode->setParent(parent);
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "identifier") == 0 ){
-            auto inode = new IdentifierNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::Identifier ){
+            auto inode = create<IdentifierNode>(parent, child);
             inode->setParent(nenode);
             nenode->addChild(inode);
             addUsedIdentifier(nenode, inode);
@@ -1563,42 +1628,42 @@ void BaseNode::visitNewExpression(BaseNode *parent, const TSNode &node)
 
 void BaseNode::visitReturnStatement(BaseNode *parent, const TSNode &node)
 {
-    ReturnStatementNode* rsnode = new ReturnStatementNode(node);
+    ReturnStatementNode* rsnode = create<ReturnStatementNode>(parent, node);
     parent->addChild(rsnode);
     visitChildren(rsnode, node);
 }
 
 void BaseNode::visitArrowFunction(BaseNode *parent, const TSNode &node){
-    ArrowFunctionNode* enode = new ArrowFunctionNode(node);
+    ArrowFunctionNode* enode = create<ArrowFunctionNode>(parent, node);
     parent->addChild(enode);
 
     // Function parameters
-    const TSNode parameters = BaseNode::nodeChildByFieldName(node, "parameters");
+    const TSNode parameters = nodeChildByField(node, LanguageSymbols::FieldParameters);
     if (!ts_node_is_null(parameters)) {
         enode->m_parameters = BaseNode::scanFormalParameters(parent, parameters);
         enode->addChild(enode->m_parameters);
     } else {
-        const TSNode parameter = BaseNode::nodeChildByFieldName(node, "parameter");
+        const TSNode parameter = nodeChildByField(node, LanguageSymbols::FieldParameter);
         if (!ts_node_is_null(parameter)) {
-            enode->m_parameters = new ParameterListNode(parameter);
+            enode->m_parameters = create<ParameterListNode>(parent, parameter);
 
-            auto nameNode = new IdentifierNode(parameter);
-            auto paramNode = new ParameterNode(parameter, nameNode);
+            auto nameNode = create<IdentifierNode>(parent, parameter);
+            auto paramNode = create<ParameterNode>(parent, parameter, nameNode);
             enode->m_parameters->m_parameters.push_back(paramNode);
         }
     }
 
     // Function return type
-    const TSNode returnType = BaseNode::nodeChildByFieldName(node, "return_type");
+    const TSNode returnType = nodeChildByField(node, LanguageSymbols::FieldReturnType);
     if (!ts_node_is_null(returnType)) {
-        enode->m_returnType = new TypeNode(returnType);
+        enode->m_returnType = create<TypeNode>(parent, returnType);
         enode->addChild(enode->m_returnType);
     }
 
     // Function body
-    const TSNode body = BaseNode::nodeChildByFieldName(node, "body");
+    const TSNode body = nodeChildByField(node, LanguageSymbols::FieldBody);
     if (!ts_node_is_null(body)) {
-        enode->m_body = new JsBlockNode(body);
+        enode->m_body = create<JsBlockNode>(parent, body);
         enode->addChild(enode->m_body);
         visitChildren(enode->m_body, body);
     }
@@ -1607,7 +1672,7 @@ void BaseNode::visitArrowFunction(BaseNode *parent, const TSNode &node){
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "async") == 0 ){
+        if ( nodeSymbol(child) == LanguageSymbols::Async ){
             enode->m_async = true;
         }
     }
@@ -1628,40 +1693,40 @@ void BaseNode::visitArrowFunction(BaseNode *parent, const TSNode &node){
 
 void BaseNode::visitObject(BaseNode *parent, const TSNode &node)
 {
-    ObjectNode* onode = new ObjectNode(node);
+    ObjectNode* onode = create<ObjectNode>(parent, node);
     parent->addChild(onode);
     visitChildren(onode, node);
 }
 
 void BaseNode::visitTryCatchBlock(BaseNode *parent, const TSNode &node){
-    TryCatchBlockNode* enode = new TryCatchBlockNode(node);
+    TryCatchBlockNode* enode = create<TryCatchBlockNode>(parent, node);
     parent->addChild(enode);
 
     uint32_t count = ts_node_child_count(node);
     for ( uint32_t i = 0; i < count; ++i ){
         TSNode child = ts_node_child(node, i);
-        if ( strcmp(ts_node_type(child), "statement_block") == 0 ){
-            enode->m_tryBody = new JsBlockNode(child);
+        if ( nodeSymbol(child) == LanguageSymbols::StatementBlock ){
+            enode->m_tryBody = create<JsBlockNode>(parent, child);
             enode->addChild(enode->m_tryBody);
             visitChildren(enode->m_tryBody, child);
-        } else if ( strcmp(ts_node_type(child), "catch_clause") == 0 ){
-            TSNode parameterNode = BaseNode::nodeChildByFieldName(child, "parameter");
-            TSNode parameterTypeNode = BaseNode::nodeChildByFieldName(child, "type");
-            if ( !ts_node_is_null(parameterNode) && strcmp(ts_node_type(parameterNode), "identifier") == 0 ){
-                auto typeNode = !ts_node_is_null(parameterTypeNode) ? new TypeNode(parameterTypeNode) : nullptr;
-                enode->m_catchParameter = new ParameterNode(parameterNode, new IdentifierNode(parameterNode), typeNode);
+        } else if ( nodeSymbol(child) == LanguageSymbols::CatchClause ){
+            TSNode parameterNode = nodeChildByField(child, LanguageSymbols::FieldParameter);
+            TSNode parameterTypeNode = nodeChildByField(child, LanguageSymbols::FieldType);
+            if ( !ts_node_is_null(parameterNode) && nodeSymbol(parameterNode) == LanguageSymbols::Identifier ){
+                auto typeNode = !ts_node_is_null(parameterTypeNode) ? create<TypeNode>(parent, parameterTypeNode) : nullptr;
+                enode->m_catchParameter = create<ParameterNode>(parent, parameterNode, create<IdentifierNode>(parent, parameterNode), typeNode);
             }
-            TSNode catchBody = BaseNode::nodeChildByFieldName(child, "body");
+            TSNode catchBody = nodeChildByField(child, LanguageSymbols::FieldBody);
             if ( !ts_node_is_null(catchBody) ){
-                enode->m_catchBody = new JsBlockNode(catchBody);
+                enode->m_catchBody = create<JsBlockNode>(parent, catchBody);
                 enode->addChild(enode->m_catchBody);
                 if ( enode->m_catchParameter ){
                     addToDeclarations(enode->m_catchBody, enode->m_catchParameter->identifier());
                 }
                 visitChildren(enode->m_catchBody, catchBody);
             }
-        } else if ( strcmp(ts_node_type(child), "finally_clause") == 0 ){
-            enode->m_finalizerBody = new JsBlockNode(child);
+        } else if ( nodeSymbol(child) == LanguageSymbols::FinallyClause ){
+            enode->m_finalizerBody = create<JsBlockNode>(parent, child);
             enode->addChild(enode->m_finalizerBody);
             visitChildren(enode->m_finalizerBody, child);
         }
@@ -1714,10 +1779,10 @@ std::string ImportNode::path(const std::string& source) const{
     return importSegments;
 }
 
-std::string ImportNode::as(const std::string &source) const{
+std::string_view ImportNode::as(const std::string &source) const{
     if ( m_importAs )
-        return slice(source, m_importAs);
-    return "";
+        return sliceView(source, m_importAs);
+    return std::string_view();
 }
 
 void ImportNode::addChild(BaseNode *child)
@@ -1739,7 +1804,7 @@ void ProgramNode::collectImportTypes(const std::string &source, ConversionContex
 
     for ( auto identifier : identifiers ){
 
-        std::string idName = slice(source, identifier);
+        std::string_view idName = sliceView(source, identifier);
 
         bool isNamespaceIdentifier = false;
 
@@ -1753,16 +1818,16 @@ void ProgramNode::collectImportTypes(const std::string &source, ConversionContex
                         auto parentCast = parent->as<ComponentDeclarationNode>();
                         if ( parentCast->heritage().size() > 1 && parentCast->heritage()[0] == identifier ){
                             ProgramNode::ImportType impt;
-                            impt.importNamespace = idName;
-                            impt.name = slice(source, parentCast->heritage()[1]);
+                            impt.importNamespace = m_strings->intern(idName);
+                            impt.name = m_strings->intern(sliceView(source, parentCast->heritage()[1]));
                             addImportType(impt);
                         }
                     } else if ( parent->isNodeType<MemberExpressionNode>() ){
                         auto parentCast = parent->as<MemberExpressionNode>();
                         if ( parentCast->children().size() > 1 && parentCast->children()[0] == identifier ){
                             ProgramNode::ImportType impt;
-                            impt.importNamespace = idName;
-                            impt.name = slice(source, parentCast->children()[1]);
+                            impt.importNamespace = m_strings->intern(idName);
+                            impt.name = m_strings->intern(sliceView(source, parentCast->children()[1]));
                             addImportType(impt);
                         }
                     } else if ( parent->isNodeType<NewComponentExpressionNode>() ||
@@ -1771,8 +1836,8 @@ void ProgramNode::collectImportTypes(const std::string &source, ConversionContex
                         auto parentCast = parent->as<NewComponentExpressionNode>();
                         if ( parentCast->name().size() > 1 && parentCast->name()[0] == identifier ){
                             ProgramNode::ImportType impt;
-                            impt.importNamespace = idName;
-                            impt.name = slice(source, parentCast->name()[1]);
+                            impt.importNamespace = m_strings->intern(idName);
+                            impt.name = m_strings->intern(sliceView(source, parentCast->name()[1]));
                             addImportType(impt);
                         }
                     }
@@ -1782,7 +1847,7 @@ void ProgramNode::collectImportTypes(const std::string &source, ConversionContex
 
         if ( !isNamespaceIdentifier ){
             ProgramNode::ImportType impt;
-            impt.name = idName;
+            impt.name = m_strings->intern(idName);
             addImportType(impt);
         }
     }
@@ -1791,9 +1856,9 @@ void ProgramNode::collectImportTypes(const std::string &source, ConversionContex
 }
 
 void ProgramNode::resolveImport(const std::string &as, const std::string &name, const std::string &path){
-    auto asIt = m_importTypes.find(as);
+    auto asIt = m_importTypes.find(m_strings->intern(as));
     if ( asIt != m_importTypes.end() ){
-        auto nameIt = asIt->second.find(name);
+        auto nameIt = asIt->second.find(m_strings->intern(name));
         if ( nameIt != asIt->second.end() ){
             nameIt->second.resolvedPath = path;
         }
@@ -1805,10 +1870,10 @@ std::string ProgramNode::importTypesString() const{
     for ( auto it = m_importTypes.begin(); it != m_importTypes.end(); ++it ){
         if ( !result.empty() )
             result += '\n';
-        result += "Imports as '" + it->first + "':";
+        result += "Imports as '" + it->first.str() + "':";
 
         for ( auto impIt = it->second.begin(); impIt != it->second.end(); ++ impIt ){
-            result += " " + impIt->second.name;
+            result += " " + impIt->second.name.str();
         }
     }
     return result;
@@ -1877,14 +1942,7 @@ void ProgramNode::collectImports(const std::string &source, std::vector<Identifi
 }
 
 void ProgramNode::addImportType(const ProgramNode::ImportType &t){
-    auto asIt = m_importTypes.find(t.importNamespace);
-    if ( asIt == m_importTypes.end() ){
-        std::map<std::string, ProgramNode::ImportType> imports;
-        imports[t.name] = t;
-        m_importTypes[t.importNamespace] = imports;
-    } else {
-        asIt->second[t.name] = t;
-    }
+    m_importTypes[t.importNamespace][t.name] = t;
 }
 
 ComponentDeclarationNode::ComponentDeclarationNode(const TSNode &node)
@@ -1924,12 +1982,12 @@ std::string ComponentDeclarationNode::toString(int indent) const{
     return result;
 }
 
-PropertyAccessorDeclarationNode::PropertyAccess ComponentDeclarationNode::propertyAccessors(const std::string &source, const std::string &propertyName){
+PropertyAccessorDeclarationNode::PropertyAccess ComponentDeclarationNode::propertyAccessors(const std::string &source, std::string_view propertyName){
     PropertyAccessorDeclarationNode::PropertyAccess result;
 
     for ( size_t j = 0; j < m_propertyAccesors.size(); ++j ){
         PropertyAccessorDeclarationNode* pa = m_propertyAccesors[j];
-        if ( slice(source, pa->name()) == propertyName ){
+        if ( sliceView(source, pa->name()) == propertyName ){
             if ( pa->access() == PropertyAccessorDeclarationNode::Getter ){
                 result.getter = pa;
                 pa->setIsPropertyAttached(true);
@@ -2031,7 +2089,7 @@ std::string ComponentBodyNode::toString(int indent) const{
 
     result += "ComponentBody " + rangeString() + "\n";
 
-    const std::vector<BaseNode*>& c = children();
+    const NodeList& c = children();
     for ( BaseNode* node : c ){
         result += node->toString(indent >= 0 ? indent + 1 : indent);
     }
@@ -2048,20 +2106,15 @@ PropertyDeclarationNode::PropertyDeclarationNode(const TSNode &node)
     , m_statementBlock(nullptr)
     , m_bindingContainer(new PropertyBindingContainer)
 {
-    m_bindingContainer->setDeclarationCheck([this](const std::string& source, const std::string& name, BaseNode* m){
+    m_bindingContainer->setDeclarationCheck([this](const std::string& source, std::string_view name, BaseNode* m){
         BaseNode* parent = m->parent();
         while ( parent ){
             if ( parent == this ){
                 break;
             }
-            JsBlockNode* hasIds = dynamic_cast<JsBlockNode*>(parent);
-            if (hasIds){
-                for (auto it = hasIds->identifiers().begin(); it != hasIds->identifiers().end(); ++it){
-                    std::string declaredId = slice(source, *it);
-                    if (declaredId == name){
-                        return true;
-                    }
-                }
+            JsBlockNode* hasIds = parent->toJsBlock();
+            if ( hasIds && hasIds->hasDeclaration(source, name) ){
+                return true;
             }
             parent = parent->parent();
         }
@@ -2099,12 +2152,21 @@ void PropertyDeclarationNode::pushToBindings(BaseNode *bn){
     m_bindingContainer->addBinding(bn);
 }
 
-std::string PropertyDeclarationNode::bindingIdentifiersToString(const std::string &source) const{
-    return m_bindingContainer->bindingIdentifiersToString(source);
+std::string PropertyDeclarationNode::bindingIdentifiersToString(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->bindingIdentifiersToString(source, strings);
+}
+
+const std::string &PropertyDeclarationNode::bindingIdentifiersToJs(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->bindingIdentifiersToJs(source, strings);
 }
 
-std::string PropertyDeclarationNode::bindingIdentifiersToJs(const std::string &source) const{
-    return m_bindingContainer->bindingIdentifiersToJs(source);
+bool PropertyDeclarationNode::hasConstantBindings(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->hasOnlyConstantDependencies(source, strings);
+}
+
+void PropertyDeclarationNode::clearSourceCaches(){
+    JsBlockNode::clearSourceCaches();
+    m_bindingContainer->invalidate();
 }
 
 StaticPropertyDeclarationNode::StaticPropertyDeclarationNode(const TSNode &node)
@@ -2142,20 +2204,15 @@ PropertyAssignmentNode::PropertyAssignmentNode(const TSNode &node)
     , m_statementBlock(nullptr)
     , m_bindingContainer(new PropertyBindingContainer)
 {
-    m_bindingContainer->setDeclarationCheck([this](const std::string& source, const std::string& name, BaseNode* m){
+    m_bindingContainer->setDeclarationCheck([this](const std::string& source, std::string_view name, BaseNode* m){
         BaseNode* parent = m->parent();
         while ( parent ){
             if ( parent == this ){
                 break;
             }
-            JsBlockNode* hasIds = dynamic_cast<JsBlockNode*>(parent);
-            if (hasIds){
-                for (auto it = hasIds->identifiers().begin(); it != hasIds->identifiers().end(); ++it){
-                    std::string declaredId = slice(source, *it);
-                    if (declaredId == name){
-                        return true;
-                    }
-                }
+            JsBlockNode* hasIds = parent->toJsBlock();
+            if ( hasIds && hasIds->hasDeclaration(source, name) ){
+                return true;
             }
             parent = parent->parent();
         }
@@ -2182,12 +2239,21 @@ void PropertyAssignmentNode::pushToBindings(BaseNode *bn){
     m_bindingContainer->addBinding(bn);
 }
 
-std::string PropertyAssignmentNode::bindingIdentifiersToString(const std::string &source) const{
-    return m_bindingContainer->bindingIdentifiersToString(source);
+std::string PropertyAssignmentNode::bindingIdentifiersToString(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->bindingIdentifiersToString(source, strings);
+}
+
+const std::string &PropertyAssignmentNode::bindingIdentifiersToJs(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->bindingIdentifiersToJs(source, strings);
 }
 
-std::string PropertyAssignmentNode::bindingIdentifiersToJs(const std::string &source) const{
-    return m_bindingContainer->bindingIdentifiersToJs(source);
+bool PropertyAssignmentNode::hasConstantBindings(const std::string &source, StringInterner &strings) const{
+    return m_bindingContainer->hasOnlyConstantDependencies(source, strings);
+}
+
+void PropertyAssignmentNode::clearSourceCaches(){
+    JsBlockNode::clearSourceCaches();
+    m_bindingContainer->invalidate();
 }
 
 EventDeclarationNode::EventDeclarationNode(const TSNode &node)
@@ -2209,11 +2275,11 @@ std::string EventDeclarationNode::toString(int indent) const{
     return result;
 }
 
-std::vector<std::string> MemberExpressionNode::identifierChain(const std::string &source) const{
-    std::vector<std::string> result;
+std::vector<std::string_view> MemberExpressionNode::identifierChain(const std::string &source) const{
+    std::vector<std::string_view> result;
     for ( auto child : children() ){
         if ( child->isNodeType<IdentifierNode>() ){
-            result.push_back(BaseNode::slice(source, child));
+            result.push_back(BaseNode::sliceView(source, child));
         } else if ( child->canCast<MemberExpressionNode>() ){
             auto nestedChain = child->as<MemberExpressionNode>()->identifierChain(source);
             result.insert( result.end(), nestedChain.begin(), nestedChain.end() );
@@ -2481,8 +2547,8 @@ std::string AssignmentExpressionNode::toString(int indent) const{
 
 void AssignmentExpressionNode::addChild(BaseNode *child){
     TSNode s = current();
-    TSNode left = ts_node_child_by_field_name(s, "left", 4);
-    TSNode right = ts_node_child_by_field_name(s, "right", 5);
+    TSNode left = nodeChildByField(s, LanguageSymbols::FieldLeft);
+    TSNode right = nodeChildByField(s, LanguageSymbols::FieldRight);
     if ( !ts_node_is_null(left) && !ts_node_is_null(right) ){
         TSNode childNode = child->current();
         if ( ts_node_eq(left, childNode) ){
@@ -2569,6 +2635,29 @@ std::string VariableDeclarationNode::toString(int indent) const
     return result;
 }
 
+/**
+ * \brief Checks whether \p id is declared directly in this block
+ *
+ * Declarations are indexed on the first lookup, as views into \p source, so lookups do not
+ * allocate. The index is rebuilt after a declaration is added or clearSourceCaches() is
+ * called, which the owner of the tree does before using it with a different source.
+ */
+bool JsBlockNode::hasDeclaration(const std::string &source, std::string_view id){
+    if ( m_declarations.empty() )
+        return false;
+
+    if ( !m_isDeclarationIndexed ){
+        m_declarationIndex.clear();
+        m_declarationIndex.reserve(m_declarations.size());
+        for ( IdentifierNode* declaration : m_declarations ){
+            m_declarationIndex.insert(sliceView(source, declaration));
+        }
+        m_isDeclarationIndexed = true;
+    }
+
+    return m_declarationIndex.find(id) != m_declarationIndex.end();
+}
+
 void JsBlockNode::collectImports(const std::string &source, std::vector<IdentifierNode *> &identifiers, ConversionContext *ctx){
     BaseNode::collectImports(source, identifiers, ctx);
     collectBlockImports(source, identifiers, ctx);
@@ -2576,7 +2665,7 @@ void JsBlockNode::collectImports(const std::string &source, std::vector<Identifi
 
 void JsBlockNode::collectBlockImports(const std::string &source, std::vector<IdentifierNode *> &identifiers, ConversionContext* ctx){
     for ( auto identifier : m_usedIdentifiers ){
-        if ( !checkIdentifierDeclared(source, this, slice(source, identifier), ctx) ){
+        if ( !checkIdentifierDeclared(source, this, sliceView(source, identifier), ctx) ){
             identifiers.push_back(identifier);
         }
     }
@@ -2617,7 +2706,7 @@ std::string TypeNode::sliceWithoutAnnotation(const std::string& source, TypeNode
         return "";
     }
 
-    if ( strcmp(ts_node_type(tn->current()), "type_annotation") == 0 ){
+    if ( nodeSymbol(tn->current()) == LanguageSymbols::TypeAnnotation ){
         auto count = ts_node_child_count(tn->current());
         if ( count > 1 ){
             uint32_t start = ts_node_start_byte(ts_node_child(tn->current(), 1));
@@ -18,6 +18,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_set>
+#include <string_view>
 
 #include "live/utf8.h"
 #include "live/mlnode.h"
@@ -26,6 +28,9 @@
 #include "tree_sitter/parser.h"
 #include "elementssections_p.h"
 #include "languagenodeinfo_p.h"
+#include "languagenodearena_p.h"
+#include "stringinterner_p.h"
+#include "languagesymbols_p.h"
 #include "languageparser.h"
 
 namespace lv{ namespace el{
@@ -66,7 +71,7 @@ class BaseNode{
 public:
     class ConversionContext{
     public:
-        ConversionContext() : jsImportsEnabled(true), allowUnresolved(true), outputComponentMeta(false), outputTypes(false){}
+        ConversionContext() : jsImportsEnabled(true), allowUnresolved(true), outputComponentMeta(false), outputTypes(false), staticBindings(false), staticDescriptors(false), flatInstances(false), compactOutput(false){}
 
         std::string baseComponent;
         std::string baseComponentImportUri;
@@ -78,12 +83,19 @@ public:
         std::string currentImportUri;
         bool        outputComponentMeta;
         bool        outputTypes;
+        bool        staticBindings;
+        bool        staticDescriptors;
+        bool        flatInstances;
+        bool        compactOutput;
 
         static std::string baseComponentName(ConversionContext* ctx);
         static std::string baseComponentImport(ConversionContext* ctx);
-        static bool isImplicitType(ConversionContext* ctx, const std::string& type);
+        static bool isImplicitType(ConversionContext* ctx, std::string_view type);
     };
 
+public:
+    typedef std::vector<BaseNode*, LanguageNodeArena::Allocator<BaseNode*> > NodeList;
+
 public:
     BaseNode(const TSNode& node, const LanguageNodeInfo::ConstPtr& ni);
     virtual ~BaseNode();
@@ -91,13 +103,18 @@ public:
     const TSNode& current() const{ return m_node; }
     std::string astString() const;
     virtual std::string toString(int indent = 0) const;
+    virtual JsBlockNode* toJsBlock(){ return nullptr; }
+    virtual void clearSourceCaches(){}
+    static void clearTreeSourceCaches(BaseNode* root);
 
     static BaseNode* visit(const std::string& filePath, const std::string& fileName, LanguageParser::AST* ast);
-    static bool checkIdentifierDeclared(const std::string& source, BaseNode* node, std::string id, ConversionContext* ctx);
+    static bool checkIdentifierDeclared(const std::string& source, BaseNode* node, std::string_view id, ConversionContext* ctx);
+    static bool isDeclaredInScope(const std::string& source, BaseNode* node, std::string_view id);
 
     template <typename T> T* as(){ return static_cast<T*>(this); }
     template <typename T> bool canCast(){ return dynamic_cast<T*>(this) != nullptr; }
-    const std::vector<BaseNode *> &children() const;
+    const NodeList& children() const;
+    LanguageNodeArena* arena() const{ return m_children.get_allocator().arena(); }
 
     int startByte() const;
     int endByte() const;
@@ -114,6 +131,7 @@ public:
 
     static std::string slice(const std::string& source, uint32_t start, uint32_t end);
     static std::string slice(const std::string& source, BaseNode* node);
+    static std::string_view sliceView(const std::string& source, BaseNode* node);
 
     static JsBlockNode* addToDeclarations(BaseNode* parent, IdentifierNode* idNode);
     static JsBlockNode* addUsedIdentifier(BaseNode* parent, IdentifierNode* idNode);
@@ -123,7 +141,8 @@ public:
 
     static std::string nodeSourceFilePath(BaseNode* node);
     static SourceRangeLocation nodeSourceLocation(BaseNode* p, const TSNode& node);
-    static TSNode nodeChildByFieldName(const TSNode& node, const std::string& name);
+    static TSNode nodeChildByField(const TSNode& node, LanguageSymbols::Field field);
+    static LanguageSymbols::Symbol nodeSymbol(const TSNode& node);
     static std::vector<IdentifierNode*> fromNestedIdentifier(BaseNode* parent, const TSNode& node);
     static ParameterListNode* scanFormalParameters(BaseNode* parent, const TSNode& formalParameters);
     static ParameterListNode* scanFormalTypeParameters(BaseNode* parent, const TSNode& formalParameters);
@@ -135,6 +154,9 @@ public:
 
 protected:
     virtual void addChild(BaseNode *child);
+    void setArena(LanguageNodeArena* arena);
+
+    template<typename T, typename ...Args> static T* create(BaseNode* owner, Args&& ...args);
 
 private:
     static void visit(BaseNode* parent, const TSNode& node);
@@ -185,12 +207,22 @@ private:
 
     static void visitDeclarationForm(BaseNode * parent, const TSNode & node, int form);
 
-    BaseNode*                  m_parent;
-    TSNode                     m_node;
-    LanguageNodeInfo::ConstPtr m_nodeInfo;
-    std::vector<BaseNode*>     m_children;
+    BaseNode*               m_parent;
+    TSNode                  m_node;
+    const LanguageNodeInfo* m_nodeInfo;
+    NodeList                m_children;
 };
 
+/**
+ * \brief Creates a node of type T in the arena \p owner belongs to
+ */
+template<typename T, typename ...Args> T* BaseNode::create(BaseNode* owner, Args&& ...args){
+    LanguageNodeArena* arena = owner->arena();
+    T* node = arena->create<T>(std::forward<Args>(args)...);
+    node->setArena(arena);
+    return node;
+}
+
 class NumberNode: public BaseNode {
     friend class BaseNode;
     LANGUAGE_NODE_INFO(NumberNode);
@@ -238,8 +270,13 @@ class JsBlockNode : public BaseNode{
     LANGUAGE_NODE_INFO(JsBlockNode);
 
 public:
-    JsBlockNode(const TSNode& node, const LanguageNodeInfo::ConstPtr& ni = JsBlockNode::nodeInfo()) : BaseNode(node, ni){}
+    JsBlockNode(const TSNode& node, const LanguageNodeInfo::ConstPtr& ni = JsBlockNode::nodeInfo())
+        : BaseNode(node, ni), m_isDeclarationIndexed(false){}
+    virtual JsBlockNode* toJsBlock() override{ return this; }
+    virtual void clearSourceCaches() override{ m_isDeclarationIndexed = false; }
+
     const std::vector<IdentifierNode*>& identifiers() const { return m_declarations; }
+    bool hasDeclaration(const std::string& source, std::string_view id);
     const std::vector<IdentifierNode*>& usedIdentifiers() const{ return m_usedIdentifiers; }
 
     virtual void collectImports(const std::string& source, std::vector<IdentifierNode *> &identifiers, ConversionContext* ctx = nullptr);
@@ -249,6 +286,10 @@ protected:
 
     std::vector<IdentifierNode*> m_declarations;
     std::vector<IdentifierNode*> m_usedIdentifiers;
+
+private:
+    std::unordered_set<std::string_view> m_declarationIndex;
+    bool                                 m_isDeclarationIndexed;
 };
 
 class ProgramNode : public JsBlockNode {
@@ -260,13 +301,19 @@ class ProgramNode : public JsBlockNode {
 public:
     class ImportType{
     public:
-        std::string name;
-        std::string importNamespace;
-        std::string resolvedPath;
+        StringInterner::Id name;
+        StringInterner::Id importNamespace;
+        std::string        resolvedPath;
     };
 
+    typedef std::map<StringInterner::Id, std::map<StringInterner::Id, ImportType> > ImportTypeMap;
+
 public:
-    ProgramNode(const TSNode& node) : JsBlockNode(node, ProgramNode::nodeInfo()), m_importTypesCollected(false) {}
+    ProgramNode(const TSNode& node)
+        : JsBlockNode(node, ProgramNode::nodeInfo())
+        , m_strings(StringInterner::create())
+        , m_importTypesCollected(false)
+    { setArena(&m_arena); }
     void setFileName(std::string fn){ m_fileName = fn; }
     std::string fileName() const { return m_fileName; }
     void setFilePath(const std::string& fp){ m_filePath = fp; }
@@ -276,7 +323,8 @@ public:
     const std::vector<ImportNode*>& imports(){ return m_imports; }
     const std::vector<JsImportNode*>& jsImports(){ return m_jsImports; }
     const std::vector<NewComponentExpressionNode*>& idComponents() const{ return m_idComponents; }
-    std::map<std::string, std::map<std::string, ImportType> >& importTypes() { return m_importTypes; }
+    ImportTypeMap& importTypes() { return m_importTypes; }
+    const StringInterner::Ptr& strings() const{ return m_strings; }
 
     void collectImportTypes(const std::string& source, ConversionContext* ctx = nullptr);
 
@@ -292,6 +340,9 @@ protected:
     virtual void collectImports(const std::string& source, std::vector<IdentifierNode *> &identifiers, ConversionContext* ctx = nullptr);
 
 private:
+    LanguageNodeArena   m_arena; // owns every node in this tree
+    StringInterner::Ptr m_strings;
+
     std::string m_fileName;
     std::string m_filePath;
 
@@ -299,7 +350,7 @@ private:
     std::vector<BaseNode*>     m_exports; // Exports are not owned
     std::vector<JsImportNode*> m_jsImports;
     bool                       m_importTypesCollected;
-    std::map<std::string, std::map<std::string, ImportType> > m_importTypes;
+    ImportTypeMap              m_importTypes;
     std::vector<NewComponentExpressionNode*> m_idComponents;
 };
 
@@ -477,7 +528,7 @@ public:
 
     bool isRelative() const{ return m_importPath && m_importPath->isRelative(); }
     std::string path(const std::string& source) const;
-    std::string as(const std::string& source) const;
+    std::string_view as(const std::string& source) const;
     bool hasNamespace() const{ return m_importAs; }
 
 protected:
@@ -597,8 +648,10 @@ public:
     JsBlockNode* statementBlock() const {return m_statementBlock; }
 
     void pushToBindings(BaseNode* bn);
-    std::string bindingIdentifiersToString(const std::string& source) const;
-    std::string bindingIdentifiersToJs(const std::string& source) const;
+    std::string bindingIdentifiersToString(const std::string& source, StringInterner& strings) const;
+    const std::string& bindingIdentifiersToJs(const std::string& source, StringInterner& strings) const;
+    bool hasConstantBindings(const std::string& source, StringInterner& strings) const;
+    virtual void clearSourceCaches() override;
 
     bool hasAssignment(){ return m_expression != nullptr || m_statementBlock != nullptr; }
     bool isBindingsAssignment(){ return m_isBindingAssignment; }
@@ -661,8 +714,10 @@ public:
     virtual std::string toString(int indent = 0) const;
 
     void pushToBindings(BaseNode* bn);
-    std::string bindingIdentifiersToString(const std::string& source) const;
-    std::string bindingIdentifiersToJs(const std::string& source) const;
+    std::string bindingIdentifiersToString(const std::string& source, StringInterner& strings) const;
+    const std::string& bindingIdentifiersToJs(const std::string& source, StringInterner& strings) const;
+    bool hasConstantBindings(const std::string& source, StringInterner& strings) const;
+    virtual void clearSourceCaches() override;
     bool isBindingAssignment() const{ return m_isBindingAssignment; }
 
     const std::vector<IdentifierNode*>& property() const{ return m_property; }
@@ -725,7 +780,7 @@ public:
     const std::vector<BaseNode*>& nestedComponents() const{ return m_nestedComponents; }
     const std::vector<NewComponentExpressionNode*>& idComponents(){ return m_idComponents; }
 
-    PropertyAccessorDeclarationNode::PropertyAccess propertyAccessors(const std::string& source, const std::string& propertyName);
+    PropertyAccessorDeclarationNode::PropertyAccess propertyAccessors(const std::string& source, std::string_view propertyName);
 
     std::string name(const std::string &source) const;
     bool isAnonymous() const;
@@ -855,7 +910,7 @@ class MemberExpressionNode : public BaseNode{
 public:
     MemberExpressionNode(const TSNode& node) : BaseNode(node, MemberExpressionNode::nodeInfo()){}
 
-    std::vector<std::string> identifierChain(const std::string& source) const;
+    std::vector<std::string_view> identifierChain(const std::string& source) const;
 };
 
 class SubscriptExpressionNode : public BaseNode{
@@ -5,13 +5,20 @@
 namespace lv{ namespace el{
 
 
-std::string LanguageNodesToJs::indent(int i){
+std::string LanguageNodesToJs::indent(int i) const{
     std::string res;
-    res.append(4 * i, ' ');
+    if ( !m_compact )
+        res.append(4 * i, ' ');
     return res;
 }
 
-LanguageNodesToJs::LanguageNodesToJs(){
+LanguageNodesToJs::LanguageNodesToJs()
+    : m_exportOutput(nullptr)
+    , m_strings(StringInterner::create())
+    , m_self("this")
+    , m_flatInstanceIndex(0)
+    , m_compact(false)
+{
 }
 
 std::string LanguageNodesToJs::slice(const std::string &source, uint32_t start, uint32_t end){
@@ -22,6 +29,14 @@ std::string LanguageNodesToJs::slice(const std::string &source, BaseNode *node){
     return slice(source, node->startByte(), node->endByte());
 }
 
+std::string_view LanguageNodesToJs::sliceView(const std::string &source, uint32_t start, uint32_t end){
+    return std::string_view(source).substr(start, end - start);
+}
+
+std::string_view LanguageNodesToJs::sliceView(const std::string &source, BaseNode *node){
+    return sliceView(source, node->startByte(), node->endByte());
+}
+
 bool LanguageNodesToJs::newLineFollows(const std::string& source, size_t startPosition){
     while ( startPosition < source.length() ){
         if ( source[startPosition] == '\n' )
@@ -82,6 +97,11 @@ void LanguageNodesToJs::convertProgram(ProgramNode *node, const std::string &sou
         THROW_EXCEPTION(lv::Exception, "Javascript imports are not enabled.", lv::Exception::toCode("~Enabled"));
     }
 
+    m_strings = node->strings();
+    m_self = "this";
+    m_flatInstanceIndex = 0;
+    m_compact = ctx && ctx->compactOutput;
+
     ElementsInsertion* importsCompose = new ElementsInsertion;
     importsCompose->from = 0;
     int to = 0;
@@ -119,35 +139,38 @@ void LanguageNodesToJs::convertProgram(ProgramNode *node, const std::string &sou
 
     if ( ctx && !ctx->baseComponentImportUri.empty() && !ctx->baseComponent.empty() ){
         ProgramNode::ImportType it;
-        it.name = ctx->baseComponent;
+        it.name = m_strings->intern(ctx->baseComponent);
         it.resolvedPath = ctx->baseComponentImportUri;
         node->addImportType(it);
     }
 
+    size_t importAliasIndex = 0;
     for ( auto it = node->importTypes().begin(); it != node->importTypes().end(); ++it ){
         if ( it->first.empty() ){
             for ( auto impIt = it->second.begin(); impIt != it->second.end(); ++ impIt ){
                 if ( !ctx->allowUnresolved && impIt->second.resolvedPath.empty() ){
                     delete importsCompose;
-                    THROW_EXCEPTION(lv::Exception, "Identifer not found in imports: \'" + impIt->second.name + "\' in " + node->filePath(), lv::Exception::toCode("~Identifier"));
+                    THROW_EXCEPTION(lv::Exception, "Identifer not found in imports: \'" + impIt->second.name.str() + "\' in " + node->filePath(), lv::Exception::toCode("~Identifier"));
                 }
                 std::string impPath = impIt->second.resolvedPath.empty() ? "__UNRESOLVED__" : impIt->second.resolvedPath;
-                *importsCompose << ("import {" + impIt->second.name + "} from '" + impPath + "'\n");
+                *importsCompose << ("import {" + impIt->second.name.str() + "} from '" + impPath + "'\n");
             }
         } else {
-            std::string moduleWrap = "let " + it->first + " = {";
+            std::string moduleWrap = "let " + it->first.str() + " = {";
             for ( auto impIt = it->second.begin(); impIt != it->second.end(); ++ impIt ){
                 if ( !ctx->allowUnresolved && impIt->second.resolvedPath.empty() ){
                     delete importsCompose;
-                    THROW_EXCEPTION(lv::Exception, "Identifer not found in imports: \'" + impIt->second.name + "\' in " + node->filePath(), lv::Exception::toCode("~Identifier"));
+                    THROW_EXCEPTION(lv::Exception, "Identifer not found in imports: \'" + impIt->second.name.str() + "\' in " + node->filePath(), lv::Exception::toCode("~Identifier"));
                 }
                 std::string impPath = impIt->second.resolvedPath.empty() ? "__UNRESOLVED__" : impIt->second.resolvedPath;
-                std::string impKey = "__" + it->first + "__" + impIt->second.name;
-                std::string impName = impIt->second.name;
+                std::string impKey = m_compact
+                    ? "__" + std::to_string(importAliasIndex++)
+                    : "__" + it->first.str() + "__" + impIt->second.name.str();
+                const std::string& impName = impIt->second.name.str();
 
                 if ( impIt != it->second.begin() )
                     moduleWrap += ", ";
-                moduleWrap += impIt->second.name + ":" + impKey;
+                moduleWrap += impIt->second.name.str() + ":" + impKey;
 
                 *importsCompose << ("import {" + impName + " as " + impKey + "} from '" + impPath + "'\n");
             }
@@ -160,8 +183,44 @@ void LanguageNodesToJs::convertProgram(ProgramNode *node, const std::string &sou
 
     size_t offset = sections.size();
 
-    for ( BaseNode* child: node->exports() )
-        convert(child, source, sections, indentValue, ctx);
+    for ( BaseNode* child: node->exports() ){
+        if ( !m_exportOutput ){
+            convert(child, source, sections, indentValue, ctx);
+            continue;
+        }
+
+        // exports already in the output are reused as they are, unless the flat instance names
+        // they took have shifted, the rest are converted and stored
+        auto exportIt = m_exportOutput->find(child);
+        if ( exportIt != m_exportOutput->end() && exportIt->second.flatInstanceStart != m_flatInstanceIndex ){
+            m_exportOutput->erase(exportIt);
+            exportIt = m_exportOutput->end();
+        }
+
+        if ( exportIt == m_exportOutput->end() ){
+            ConvertedExport converted;
+            converted.flatInstanceStart = m_flatInstanceIndex;
+
+            JSSection exportSection(child->startByte(), child->endByte());
+            convert(child, source, exportSection.m_children, indentValue, ctx);
+
+            OutputBuffer flatten;
+            exportSection.flatten(source, flatten);
+            converted.js = flatten.toString();
+            converted.flatInstanceEnd = m_flatInstanceIndex;
+            exportIt = m_exportOutput->insert(std::make_pair(child, std::move(converted))).first;
+
+            for ( ElementsInsertion* ei : exportSection.m_children )
+                delete ei;
+        }
+        m_flatInstanceIndex = exportIt->second.flatInstanceEnd;
+
+        ElementsInsertion* exportCompose = new ElementsInsertion;
+        exportCompose->from = child->startByte();
+        exportCompose->to   = child->endByte();
+        *exportCompose << exportIt->second.js;
+        sections.push_back(exportCompose);
+    }
 
 //    BaseNode::convertToJs(source, fragments, indentValue);
 
@@ -185,6 +244,8 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
     compose->to   = node->endByte();
 
     std::string componentName = node->name(source);
+    std::string parentSelf = m_self;
+    m_self = "this";
 
     std::string heritage = "";
     if ( node->heritage().size() > 0 ){
@@ -222,7 +283,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             *compose << "()";
         }
 
-        *compose << slice(source, node->componentBody()->constructor()->body()->startByte(), node->componentBody()->constructor()->body()->endByte()) << "\n";
+        *compose << sliceView(source, node->componentBody()->constructor()->body()->startByte(), node->componentBody()->constructor()->body()->endByte()) << "\n";
 
     } else {
         *compose << indent(indentValue + 1) << "constructor(){\n"
@@ -237,36 +298,70 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
         *compose << indent(indentValue + 2) << "this.ids = {}\n\n";
 
     if (node->componentId()){
-        *compose << indent(indentValue + 2) << "var " << slice(source, node->componentId()) << " = this\n";
-        *compose << indent(indentValue + 2) << "this.ids[\"" << slice(source, node->componentId()) << "\"] = " << slice(source, node->componentId()) << "\n\n";
+        *compose << indent(indentValue + 2) << "var " << sliceView(source, node->componentId()) << " = this\n";
+        *compose << indent(indentValue + 2) << "this.ids[\"" << sliceView(source, node->componentId()) << "\"] = " << sliceView(source, node->componentId()) << "\n\n";
     }
 
     for (size_t i = 0; i < node->idComponents().size(); ++i)
     {
-        *compose << indent(indentValue + 2) << "var " << slice(source, node->idComponents()[i]->id()) << " = new " << node->idComponents()[i]->initializerName(source);
+        *compose << indent(indentValue + 2) << "var " << sliceView(source, node->idComponents()[i]->id()) << " = new " << node->idComponents()[i]->initializerName(source);
         if (node->idComponents()[i]->arguments())
-            *compose << slice(source, node->idComponents()[i]->arguments()) << "\n";
+            *compose << sliceView(source, node->idComponents()[i]->arguments()) << "\n";
         else
             *compose << "()\n";
-        *compose << indent(indentValue + 2) << "this.ids[\"" << slice(source, node->idComponents()[i]->id()) << "\"] = " << slice(source, node->idComponents()[i]->id()) << "\n\n";
+        *compose << indent(indentValue + 2) << "this.ids[\"" << sliceView(source, node->idComponents()[i]->id()) << "\"] = " << sliceView(source, node->idComponents()[i]->id()) << "\n\n";
     }
 
     for (size_t i = 0; i < node->idComponents().size();++i)
     {
         std::string id = slice(source, node->idComponents()[i]->id());
-        auto properties = node->idComponents()[i]->properties();
+        const auto& properties = node->idComponents()[i]->properties();
 
         for (uint32_t idx = 0; idx < properties.size(); ++idx){
-            std::string propertyName = slice(source, properties[idx]->name());
             PropertyAccessorDeclarationNode::PropertyAccess accessPair;
             convertPropertyDeclaration(properties[idx], source, id, indentValue + 2, ctx, accessPair, compose);
         }
     }
 
+    // in static descriptor mode, descriptors are written once into frozen tables on the class,
+    // and __initialize registers a copy of each, since addProperty may keep or write to the
+    // descriptor it receives. Properties with accessors keep the per-instance form, as their
+    // functions refer to the ids declared in __initialize
+    bool staticDescriptors = ctx && ctx->staticDescriptors && !node->isAnonymous();
+    std::string propertyTableName = m_compact ? "__pd" : "__propertyDescriptors";
+    std::string eventTableName = m_compact ? "__ed" : "__eventDescriptors";
+    ElementsInsertion* propertyTable = nullptr;
+    ElementsInsertion* accessorProperties = nullptr;
+    std::string eventTable;
+
     for (size_t i = 0; i < node->properties().size(); ++i){
-        std::string propertyName = slice(source, node->properties()[i]->name());
+        std::string_view propertyName = sliceView(source, node->properties()[i]->name());
         PropertyAccessorDeclarationNode::PropertyAccess accessPair = node->propertyAccessors(source, propertyName);
-        convertPropertyDeclaration(node->properties()[i], source, "this", indentValue + 2, ctx, accessPair, compose);
+        if ( staticDescriptors && !accessPair.getter && !accessPair.setter ){
+            if ( !propertyTable )
+                propertyTable = new ElementsInsertion;
+            *propertyTable << indent(indentValue + 1) << "['" << propertyName << "', Object.freeze(";
+            convertPropertyDescriptor(node->properties()[i], source, indentValue + 1, ctx, accessPair, propertyTable);
+            *propertyTable << ")],\n";
+        } else if ( staticDescriptors ){
+            if ( !accessorProperties )
+                accessorProperties = new ElementsInsertion;
+            convertPropertyDeclaration(node->properties()[i], source, "this", indentValue + 2, ctx, accessPair, accessorProperties);
+        } else {
+            convertPropertyDeclaration(node->properties()[i], source, "this", indentValue + 2, ctx, accessPair, compose);
+        }
+    }
+
+    if ( propertyTable ){
+        *compose << indent(indentValue + 2) << "for ( let __p = 0; __p < " << componentName << "." << propertyTableName << ".length; ++__p )\n"
+                 << indent(indentValue + 3) << BaseNode::ConversionContext::baseComponentName(ctx) << ".addProperty(this, "
+                 << componentName << "." << propertyTableName << "[__p][0], Object.assign({}, " << componentName << "." << propertyTableName << "[__p][1]))\n";
+    }
+    if ( accessorProperties ){
+        OutputBuffer flat;
+        accessorProperties->flatten(source, flat);
+        *compose << flat;
+        delete accessorProperties;
     }
 
     for (size_t i = 0; i < node->events().size(); ++i){
@@ -280,7 +375,17 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             }
         }
 
-        *compose << indent(indentValue + 1) << (BaseNode::ConversionContext::baseComponentName(ctx) + ".addEvent(this, \'" + slice(source, node->events()[i]->name()) + "\', [" + paramList + "])\n");
+        if ( staticDescriptors ){
+            eventTable += indent(indentValue + 1) + "['" + slice(source, node->events()[i]->name()) + "', Object.freeze([" + paramList + "])],\n";
+        } else {
+            *compose << indent(indentValue + 2) << (BaseNode::ConversionContext::baseComponentName(ctx) + ".addEvent(this, \'" + slice(source, node->events()[i]->name()) + "\', [" + paramList + "])\n");
+        }
+    }
+
+    if ( !eventTable.empty() ){
+        *compose << indent(indentValue + 2) << "for ( let __e = 0; __e < " << componentName << "." << eventTableName << ".length; ++__e )\n"
+                 << indent(indentValue + 3) << BaseNode::ConversionContext::baseComponentName(ctx) << ".addEvent(this, "
+                 << componentName << "." << eventTableName << "[__e][0], " << componentName << "." << eventTableName << "[__e][1].slice())\n";
     }
 
     for (size_t i = 0; i < node->listeners().size(); ++i){
@@ -295,7 +400,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             }
         }
 
-        *compose << indent(indentValue + 2) << "this.on(\'" << slice(source, node->listeners()[i]->name()) << "\', function(" << paramList << ")";
+        *compose << indent(indentValue + 2) << "this.on(\'" << sliceView(source, node->listeners()[i]->name()) << "\', function(" << paramList << ")";
 
         if ( node->listeners()[i]->body() ){
             JSSection* jssection = new JSSection;
@@ -314,9 +419,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
 
     for (size_t i = 0; i < node->properties().size(); ++i){
 
-        std::string bindingsInJs = node->properties()[i]->bindingIdentifiersToJs(source);
+        const std::string& bindingsInJs = node->properties()[i]->bindingIdentifiersToJs(source, *m_strings);
 
-        if (bindingsInJs.size() > 0 && node->properties()[i]->isBindingsAssignment() ){
+        if (bindingsInJs.size() > 0 && node->properties()[i]->isBindingsAssignment() && !isStaticBinding(node->properties()[i], source, ctx) ){
             std::string comp = indent(indentValue + 1) + BaseNode::ConversionContext::baseComponentName(ctx) + ".assignPropertyExpression(this,\n"
                              + indent(indentValue + 1) + "'" + slice(source, node->properties()[i]->name()) + "',\n";
             if (node->properties()[i]->expression()){
@@ -327,10 +432,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 section->to = expr->endByte();
                 convert(expr, source, section->m_children, indentValue + 1, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    comp += s;
+                flat.appendTo(comp);
                 delete section;
                 comp += "}.bind(this),\n";
             } else if (node->properties()[i]->statementBlock()){
@@ -341,10 +445,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indentValue + 1, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    comp += s;
+                flat.appendTo(comp);
                 delete section;
                 comp += ".bind(this)\n),\n";
             }
@@ -352,7 +455,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             comp += indent(indentValue + 1) + ")\n";
             *compose << comp;
         } else if ( node->properties()[i]->hasAssignment() ){
-            *compose << indent(indentValue + 2) << "this." << slice(source,node->properties()[i]->name())
+            *compose << indent(indentValue + 2) << "this." << sliceView(source,node->properties()[i]->name())
                      << " = ";
             if (node->properties()[i]->expression()){
                 auto expr = node->properties()[i]->expression();
@@ -361,10 +464,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 expressionSection->from = expr->startByte();
                 expressionSection->to   = expr->endByte();
                 convert(expr, source, expressionSection->m_children, indentValue + 2, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
                 delete expressionSection;
 
                 *compose << "\n";
@@ -375,10 +477,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 section->from = block->startByte();
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indentValue + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
                 delete section;
                 *compose << ".bind(this))()\n";
             }
@@ -387,9 +488,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
 
     for (size_t i = 0; i < node->assignments().size(); ++i){
 
-        std::string bindingsInJs = node->assignments()[i]->bindingIdentifiersToJs(source);
+        const std::string& bindingsInJs = node->assignments()[i]->bindingIdentifiersToJs(source, *m_strings);
 
-        if ( bindingsInJs.length() > 0 && node->assignments()[i]->isBindingAssignment() ){
+        if ( bindingsInJs.length() > 0 && node->assignments()[i]->isBindingAssignment() && !isStaticBinding(node->assignments()[i], source, ctx) ){
             if (node->assignments()[i]->expression()){
                 auto& property = node->assignments()[i]->property();
                 std::string object = "this";
@@ -398,7 +499,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 }
 
                 *compose << indent(indentValue + 2) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignPropertyExpression(" << object << ",\n"
-                         << indent(indentValue + 3) << "'" << slice(source, property[property.size()-1])
+                         << indent(indentValue + 3) << "'" << sliceView(source, property[property.size()-1])
                          << "',\n" << indent(indentValue + 3) << "function(){ return ";
 
                 auto expr = node->assignments()[i]->expression();
@@ -406,10 +507,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 expressionSection->from = expr->startByte();
                 expressionSection->to   = expr->endByte();
                 convert(expr, source, expressionSection->m_children, indentValue + 4, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
                 delete expressionSection;
 
                 *compose << "}.bind(" << object << "),\n"
@@ -423,7 +523,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 }
 
                 *compose << indent(indentValue + 2) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignPropertyExpression(" << object << ",\n"
-                         << indent(indentValue + 3) << "'" << slice(source, property[property.size() - 1])
+                         << indent(indentValue + 3) << "'" << sliceView(source, property[property.size() - 1])
                          << "',\n" << indent(indentValue + 3) << "function()";
 
                 auto expr = node->assignments()[i]->statementBlock();
@@ -431,10 +531,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 expressionSection->from = expr->startByte();
                 expressionSection->to   = expr->endByte();
                 convert(expr, source, expressionSection->m_children, indentValue + 4, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
                 delete expressionSection;
 
                 *compose << ".bind(" << object << "),\n"
@@ -446,7 +545,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 *compose << indent(indentValue + 2) << "this";
 
                 for (size_t prop = 0; prop < node->assignments()[i]->property().size(); ++prop){
-                    *compose << "." << slice(source, node->assignments()[i]->property()[prop]);
+                    *compose << "." << sliceView(source, node->assignments()[i]->property()[prop]);
                 }
 
                 auto expr = node->assignments()[i]->expression();
@@ -455,11 +554,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 section->from = expr->startByte();
                 section->to = expr->endByte();
                 convert(expr, source, section->m_children, indentValue + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat){
-                    comp += s;
-                }
+                flat.appendTo(comp);
                 delete section;
 
                 *compose << " = " << comp << "\n"; //slice(source, m_assignments[i]->m_expression) << "\n\n";
@@ -478,11 +575,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
                 section->from = block->startByte();
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indentValue + 3, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat) {
-                    *compose << s;
-                }
+                *compose << flat;
                 delete section;
 
                 *compose << ".bind(this)())\n\n";
@@ -490,7 +585,10 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
         }
     }
 
-    if (!node->nestedComponents().empty()){
+    if (!node->nestedComponents().empty() && canFlattenInstances(node->nestedComponents(), source, ctx)){
+        std::string children = convertFlatInstances(node->nestedComponents(), source, indentValue + 2, ctx, compose);
+        *compose << indent(indentValue + 2) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignChildren(this, [" << children << "])\n";
+    } else if (!node->nestedComponents().empty()){
         *compose << indent(indentValue + 2) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignChildren(this, [\n";
         for (size_t i = 0; i < node->nestedComponents().size(); ++i)
         {
@@ -500,10 +598,9 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             section->from = node->nestedComponents()[i]->startByte();
             section->to = node->nestedComponents()[i]->endByte();
             convert(node->nestedComponents()[i], source, section->m_children, indentValue + 3, ctx);
-            std::vector<std::string> flat;
+            OutputBuffer flat;
             section->flatten(source, flat);
-            for (auto s: flat)
-                *compose << s;
+            *compose << flat;
             delete section;
         }
         *compose << indent(indentValue + 2) << "])\n";
@@ -534,10 +631,10 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             jssection->from = pa->body()->startByte();
             jssection->to   = pa->body()->endByte();
             convert(pa->body(), source, jssection->m_children, indentValue + 1, ctx);
-            std::vector<std::string> flat;
+            OutputBuffer flat;
             jssection->flatten(source, flat);
-            for (auto s: flat){
-                *compose << s << "\n";
+            for ( const OutputBuffer::Span& s : flat.parts() ){
+                *compose << std::string(s.data, s.size) << "\n";
             }
             delete jssection;
             *compose << "\n";
@@ -561,7 +658,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
             annotations += "static ";
         if ( tfdn->isAsync() )
             annotations += "async ";
-        *compose << indent(indentValue + 1) << annotations << slice(source, tfdn->name()) << "(" << paramList << ")";
+        *compose << indent(indentValue + 1) << annotations << sliceView(source, tfdn->name()) << "(" << paramList << ")";
 
         JSSection* jssection = new JSSection;
         jssection->from = tfdn->body()->startByte();
@@ -572,9 +669,19 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
 
     *compose << indent(indentValue) << "}\n";
 
+    if ( propertyTable ){
+        OutputBuffer flat;
+        propertyTable->flatten(source, flat);
+        *compose << indent(indentValue) << componentName << "." << propertyTableName << " = Object.freeze([\n" << flat << indent(indentValue) << "])\n";
+        delete propertyTable;
+    }
+    if ( !eventTable.empty() ){
+        *compose << indent(indentValue) << componentName << "." << eventTableName << " = Object.freeze([\n" << eventTable << indent(indentValue) << "])\n";
+    }
+
     for ( auto it = node->staticProperties().begin(); it != node->staticProperties().end(); ++it ){
         StaticPropertyDeclarationNode* spd = (*it)->as<StaticPropertyDeclarationNode>();
-        *compose << indent(indentValue)  << componentName << "." << slice(source, spd->name());
+        *compose << indent(indentValue)  << componentName << "." << sliceView(source, spd->name());
         if ( spd->expression() ){
             *compose << " = ";
             JSSection* jssection = new JSSection;
@@ -596,6 +703,7 @@ void LanguageNodesToJs::convertComponentDeclaration(ComponentDeclarationNode *no
         *compose << indent(indentValue) << "}";
     }
 
+    m_self = parentSelf;
     sections.push_back(compose);
 }
 
@@ -614,36 +722,65 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
         *compose << indent(indt);
     *compose << "(function(parent){\n" << indent(indt + 1) << "this.setParent(parent)\n";
 
-    std::string id_root = "this";
+    std::string parentSelf = m_self;
+    m_self = "this";
+    convertNewComponentBody(node, source, indt, ctx, compose);
+    m_self = parentSelf;
+
+    *compose << indent(indt + 1) << "return this\n" << indent(indt) << "}.bind(" << newInstanceExpression(node, source);
+
+    bool isThis = node->parent() && node->parent()->isNodeType<ComponentBodyNode>() ;
+    isThis = isThis || (node->parent()
+                        && node->parent()->parent()
+                        && node->parent()->parent()->isNodeType<PropertyDeclarationNode>()
+                        && node->parent()->parent()->parent()
+                        && node->parent()->parent()->parent()->isNodeType<ComponentBodyNode>() );
+
+    if (isThis){
+        *compose << ")(" << parentSelf << ")";
+    } else {
+        *compose << ")(null)";
+    }
+
+    *compose << ")\n";
+
+    sections.push_back(compose);
+}
+
+/**
+ * \brief Writes the statements that set up the instance \p node, referenced through the current self
+ */
+void LanguageNodesToJs::convertNewComponentBody(NewComponentExpressionNode *node, const std::string &source, int indt, BaseNode::ConversionContext *ctx, ElementsInsertion *compose){
+    const std::string self = m_self;
+    std::string id_root = self;
     bool isRoot = (dynamic_cast<RootNewComponentExpressionNode*>(node) != nullptr);
     if (isRoot && (!node->idComponents().empty() || node->id() ) ) {
-        *compose << indent(indt + 1) << "this.ids = {}\n\n";
+        *compose << indent(indt + 1) << self << ".ids = {}\n\n";
     }
 
     if (node->id()) {
-        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignId(" << slice(source, node->id()) << ", \"" << slice(source, node->id()) << "\")\n";
+        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignId(" << sliceView(source, node->id()) << ", \"" << sliceView(source, node->id()) << "\")\n";
         if (isRoot){
             id_root = slice(source, node->id());
-            *compose << indent(indt + 1) << "var " << id_root << " = this\n";
-            *compose << indent(indt + 1) << "this.ids[\"" << id_root << "\"] = " << id_root << "\n";
+            *compose << indent(indt + 1) << "var " << id_root << " = " << self << "\n";
+            *compose << indent(indt + 1) << self << ".ids[\"" << id_root << "\"] = " << id_root << "\n";
         }
     }
 
     if (isRoot && !node->idComponents().empty()){
         for (size_t i = 0; i < node->idComponents().size();++i){
             auto type = node->idComponents()[i]->initializerName(source);
-            *compose << indent(indt + 1) << "var " << slice(source, node->idComponents()[i]->id()) << " = new " << type;
+            *compose << indent(indt + 1) << "var " << sliceView(source, node->idComponents()[i]->id()) << " = new " << type;
             if (node->idComponents()[i]->arguments())
-                *compose << slice(source, node->idComponents()[i]->arguments()) << "\n";
+                *compose << sliceView(source, node->idComponents()[i]->arguments()) << "\n";
             else
                 *compose << "()\n";
-            *compose << indent(indt + 1) << "this.ids[\"" << slice(source, node->idComponents()[i]->id()) << "\"] = " << slice(source, node->idComponents()[i]->id()) << "\n\n";
+            *compose << indent(indt + 1) << self << ".ids[\"" << sliceView(source, node->idComponents()[i]->id()) << "\"] = " << sliceView(source, node->idComponents()[i]->id()) << "\n\n";
         }
     }
 
     if (isRoot || !node->id()){
         for (size_t i = 0; i < node->properties().size(); ++i){
-            std::string propertyName = slice(source, node->properties()[i]->name());
             PropertyAccessorDeclarationNode::PropertyAccess accessPair;
             convertPropertyDeclaration(node->properties()[i], source, id_root, indt + 2, ctx, accessPair, compose);
         }
@@ -652,10 +789,9 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
     if (isRoot && !node->idComponents().empty()){
         for (size_t i = 0; i < node->idComponents().size();++i){
             std::string id = slice(source, node->idComponents()[i]->id());
-            auto properties = node->idComponents()[i]->properties();
+            const auto& properties = node->idComponents()[i]->properties();
 
             for (size_t idx = 0; idx < properties.size(); ++idx){
-                std::string propertyName = slice(source, properties[idx]->name());
                 PropertyAccessorDeclarationNode::PropertyAccess accessPair;
                 convertPropertyDeclaration(properties[idx], source, id, indt + 1, ctx, accessPair, compose);
             }
@@ -664,11 +800,11 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
 
     for (size_t i = 0; i < node->properties().size(); ++i){
 
-        std::string bindingsInJs = node->properties()[i]->bindingIdentifiersToJs(source);
-        if (bindingsInJs.size() > 0 && node->properties()[i]->isBindingsAssignment() ){
+        const std::string& bindingsInJs = node->properties()[i]->bindingIdentifiersToJs(source, *m_strings);
+        if (bindingsInJs.size() > 0 && node->properties()[i]->isBindingsAssignment() && !isStaticBinding(node->properties()[i], source, ctx) ){
             std::string comp = "";
             if (node->properties()[i]->expression()){
-                comp += indent(indt + 1) + BaseNode::ConversionContext::baseComponentName(ctx) + ".assignPropertyExpression(this,\n"
+                comp += indent(indt + 1) + BaseNode::ConversionContext::baseComponentName(ctx) + ".assignPropertyExpression(" + self + ",\n"
                       + indent(indt + 2) + "'" + slice(source, node->properties()[i]->name()) + "',\n"
                       + indent(indt + 2) + "function(){ return ";
 
@@ -676,28 +812,26 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 expressionSection->from = node->properties()[i]->expression()->startByte();
                 expressionSection->to   = node->properties()[i]->expression()->endByte();
                 convert(node->properties()[i], source, expressionSection->m_children, indt + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    comp += s;
+                flat.appendTo(comp);
 
-                comp += "}.bind(this),\n"
+                comp += "}.bind(" + self + "),\n"
                       + indent(indt + 2) + bindingsInJs + "\n";
                 comp += indent(indt + 1) +  + ")\n";
             } else {
-                comp += indent(indt + 1) + BaseNode::ConversionContext::baseComponentName(ctx) + ".assignPropertyExpression(this,\n"
+                comp += indent(indt + 1) + BaseNode::ConversionContext::baseComponentName(ctx) + ".assignPropertyExpression(" + self + ",\n"
                       + indent(indt + 2) + "'" + slice(source, node->properties()[i]->name()) + "',\n" + indent(indt + 2) + "function()";
                 el::JSSection* section = new el::JSSection;
                 auto block = node->properties()[i]->statementBlock();
                 section->from = block->startByte();
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indt + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    comp += s;
+                flat.appendTo(comp);
                 delete section;
-                comp += ".bind(this),\n"
+                comp += ".bind(" + self + "),\n"
                       + indent(indt + 1) + bindingsInJs + "\n";
                 comp += indent(indt + 1) + ")\n";
             }
@@ -706,34 +840,32 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
         } else if ( node->properties()[i]->hasAssignment() ){
             if (node->properties()[i]->expression()){
                 auto expr = node->properties()[i]->expression();
-                *compose << indent(indt + 1) << "this." << slice(source, node->properties()[i]->name()) << " = ";
+                *compose << indent(indt + 1) << self << "." << sliceView(source, node->properties()[i]->name()) << " = ";
 
                 // convert the subexpression
                 JSSection* expressionSection = new JSSection;
                 expressionSection->from = expr->startByte();
                 expressionSection->to   = expr->endByte();
                 convert(expr, source, expressionSection->m_children, indt + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
 
                 *compose << "\n";
             } else if (node->properties()[i]->statementBlock()) {
-                *compose << indent(indt + 1) << "this." << slice(source, node->properties()[i]->name()) << " = " << "(function()";
+                *compose << indent(indt + 1) << self << "." << sliceView(source, node->properties()[i]->name()) << " = " << "(function()";
                 el::JSSection* section = new el::JSSection;
                 auto block = node->properties()[i]->statementBlock();
                 section->from = block->startByte();
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indt + 2, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    *compose <<  s;
+                *compose << flat;
                 delete section;
 
-                *compose << ".bind(this)())\n\n";
+                *compose << ".bind(" << self << ")())\n\n";
             }
         }
     }
@@ -743,16 +875,16 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
         if ( assignment->property().size() == 0 )
             continue;
 
-        std::string bindingsInJs = node->assignments()[i]->bindingIdentifiersToJs(source);
-        if ( bindingsInJs.length() > 0 && assignment->isBindingAssignment()){ // has bindings
+        const std::string& bindingsInJs = node->assignments()[i]->bindingIdentifiersToJs(source, *m_strings);
+        if ( bindingsInJs.length() > 0 && assignment->isBindingAssignment() && !isStaticBinding(assignment, source, ctx) ){ // has bindings
             if (assignment->expression() ){
                 auto& property = assignment->property();
-                std::string object = "this";
+                std::string object = self;
                 for (size_t x = 0; x < property.size() - 1; x++){
                     object += "." + slice(source, property[x]);
                 }
                 *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignPropertyExpression(" << object << ",\n"
-                         << indent(indt + 2) << "'" << slice(source, property[property.size()-1]) << "',\n"
+                         << indent(indt + 2) << "'" << sliceView(source, property[property.size()-1]) << "',\n"
                          << indent(indt + 2) << "function(){ return ";
 
                 el::JSSection* section = new el::JSSection;
@@ -761,10 +893,9 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 section->to = expr->endByte();
                 convert(expr, source, section->m_children, indt + 2, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    *compose <<  s;
+                *compose << flat;
                 delete section;
 
                 *compose << "}.bind(" << object << "),\n"
@@ -772,12 +903,12 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                          << indent(indt + 1) << ")\n";
             } else if ( assignment->statementBlock() ){
                 auto& property = assignment->property();
-                std::string object = "this";
+                std::string object = self;
                 for (size_t x = 0; x < property.size() - 1; x++){
                     object += "." + slice(source, property[x]);
                 }
                 *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignPropertyExpression(" << object << ",\n"
-                         << indent(indt + 2) << "'" << slice(source, property[property.size()-1]) << "',\n"
+                         << indent(indt + 2) << "'" << sliceView(source, property[property.size()-1]) << "',\n"
                          << indent(indt + 2) << "function()";
 
                 el::JSSection* section = new el::JSSection;
@@ -786,10 +917,9 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indt + 2, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    *compose <<  s;
+                *compose << flat;
                 delete section;
 
                 *compose << ".bind(" << object << "),\n"
@@ -798,10 +928,10 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
             }
         } else {
             if (assignment->expression()){
-                *compose << indent(indt + 1) << "this";
+                *compose << indent(indt + 1) << self;
                 auto expr = assignment->expression();
                 for (size_t prop = 0; prop < assignment->property().size(); ++prop){
-                    *compose << "." << slice(source, assignment->property()[prop]);
+                    *compose << "." << sliceView(source, assignment->property()[prop]);
                 }
                 *compose << " = ";
 
@@ -810,15 +940,14 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 expressionSection->from = expr->startByte();
                 expressionSection->to   = expr->endByte();
                 convert(expr, source, expressionSection->m_children, indt + 1, ctx);
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 expressionSection->flatten(source, flat);
-                for (auto s: flat)
-                    *compose << s;
+                *compose << flat;
 
                 *compose << "\n";
 
             } else if (assignment->statementBlock() ) {
-                std::string propName = "this";
+                std::string propName = self;
                 for (size_t prop = 0; prop <assignment->property().size(); ++prop){
                     propName += "." + slice(source, assignment->property()[prop]);
                 }
@@ -830,13 +959,12 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 section->to = block->endByte();
                 convert(block, source, section->m_children, indt + 2, ctx);
 
-                std::vector<std::string> flat;
+                OutputBuffer flat;
                 section->flatten(source, flat);
-                for (auto s: flat)
-                    *compose <<  s;
+                *compose << flat;
                 delete section;
 
-                *compose << ".bind(this)())\n";
+                *compose << ".bind(" << self << ")())\n";
             }
         }
     }
@@ -853,7 +981,7 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
                 paramList += "[\'" + TypeNode::sliceWithoutAnnotation(source, (*it)->type()) + "\',\'" + slice(source, (*it)->identifier()) + "\']";
             }
         }
-        *compose << indent(indt + 1) << (BaseNode::ConversionContext::baseComponentName(ctx) + ".addEvent(this, \'" + slice(source, edn->name()) + "\', [" + paramList + "])\n");
+        *compose << indent(indt + 1) << (BaseNode::ConversionContext::baseComponentName(ctx) + ".addEvent(" + self + ", \'" + slice(source, edn->name()) + "\', [" + paramList + "])\n");
     }
 
     for ( auto it = node->listeners().begin(); it != node->listeners().end(); ++it ){
@@ -869,20 +997,20 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
             }
         }
 
-        *compose << indent(indt + 1) << "this.on(\'" << slice(source, ldn->name()) << "\', function(" << paramList << ")";
+        *compose << indent(indt + 1) << self << ".on(\'" << sliceView(source, ldn->name()) << "\', function(" << paramList << ")";
 
         if ( ldn->body() ){
             JSSection* jssection = new JSSection;
             jssection->from = ldn->body()->startByte();
             jssection->to   = ldn->body()->endByte();
             convert(ldn->body(), source, jssection->m_children, indt + 1, ctx);
-            *compose << jssection << ".bind(this));\n";
+            *compose << jssection << ".bind(" << self << "));\n";
         } else {
             JSSection* jssection = new JSSection;
             jssection->from = ldn->bodyExpression()->startByte();
             jssection->to   = ldn->bodyExpression()->endByte();
             convert(ldn->bodyExpression(), source, jssection->m_children, indt + 1, ctx);
-            *compose << "{" << jssection << "}.bind(this));\n";
+            *compose << "{" << jssection << "}.bind(" << self << "));\n";
         }
     }
 
@@ -903,67 +1031,120 @@ void LanguageNodesToJs::convertNewComponentExpression(NewComponentExpressionNode
         jssection->to   = tfdn->body()->endByte();
         convert(tfdn, source, jssection->m_children, indt + 2, ctx);
         *compose << indent(indt + 1) <<
-                    "this." << slice(source, tfdn->name()) << " = " <<
+                    self << "." << sliceView(source, tfdn->name()) << " = " <<
                     (tfdn->isAsync() ? "async " : "") <<
                     "function(" << paramList << ")" << jssection << "\n";
     }
 
-    if (!node->nestedComponents().empty()){
-        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignChildrenAndComplete(this, [\n";
+    if (!node->nestedComponents().empty() && canFlattenInstances(node->nestedComponents(), source, ctx)){
+        std::string children = convertFlatInstances(node->nestedComponents(), source, indt + 1, ctx, compose);
+        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignChildrenAndComplete(" << self << ", [" << children << "])\n";
+    } else if (!node->nestedComponents().empty()){
+        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".assignChildrenAndComplete(" << self << ", [\n";
         for (unsigned i = 0; i < node->nestedComponents().size(); ++i){
             if (i != 0) *compose << ",\n";
             el::JSSection* section = new el::JSSection;
             section->from = node->nestedComponents()[i]->startByte();
             section->to = node->nestedComponents()[i]->endByte();
             convert(node->nestedComponents()[i], source, section->m_children, indt + 2, ctx);
-            std::vector<std::string> flat;
+            OutputBuffer flat;
             section->flatten(source, flat);
-            for (auto s: flat)
-                *compose << s << "\n";
+            for ( const OutputBuffer::Span& s : flat.parts() ){
+                *compose << std::string(s.data, s.size) << "\n";
+            }
             delete section;
         }
         *compose << indent(indt + 1) << "])\n";
     } else {
-        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".complete(this)\n";
+        *compose << indent(indt + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".complete(" << self << ")\n";
     }
 
-    *compose << indent(indt + 1) << "return this\n" << indent(indt) << "}.bind(";
-
-    if (!node->id() || isRoot)
-    {
-        *compose << "new ";
-        std::string name;
-        for ( auto nameIden : node->name() ){
-            if ( !name.empty() )
-                name += ".";
-            name += slice(source, nameIden);
-        }
-        *compose << name;
+}
 
-        if (!node->arguments())
-            *compose << "()";
-        else
-            *compose << slice(source, node->arguments());
-    } else {
-        *compose << slice(source, node->id());
+/**
+ * \brief Returns the expression that creates (or for ids, references) the object of \p node
+ */
+std::string LanguageNodesToJs::newInstanceExpression(NewComponentExpressionNode *node, const std::string &source){
+    bool isRoot = (dynamic_cast<RootNewComponentExpressionNode*>(node) != nullptr);
+    if ( node->id() && !isRoot )
+        return slice(source, node->id());
+
+    std::string result = "new ";
+    for ( size_t i = 0; i < node->name().size(); ++i ){
+        if ( i != 0 )
+            result += ".";
+        result += sliceView(source, node->name()[i]);
     }
+    if ( node->arguments() )
+        result += sliceView(source, node->arguments());
+    else
+        result += "()";
+    return result;
+}
 
-    bool isThis = node->parent() && node->parent()->isNodeType<ComponentBodyNode>() ;
-    isThis = isThis || (node->parent()
-                        && node->parent()->parent()
-                        && node->parent()->parent()->isNodeType<PropertyDeclarationNode>()
-                        && node->parent()->parent()->parent()
-                        && node->parent()->parent()->parent()->isNodeType<ComponentBodyNode>() );
+/**
+ * \brief Checks whether \p instances can be written as straight-line statements instead of nested closures
+ *
+ * Only plain child instances qualify, and only when their source never refers to \c this or \c arguments,
+ * since those would resolve differently once the closure around them is gone.
+ */
+bool LanguageNodesToJs::canFlattenInstances(const std::vector<BaseNode *> &instances, const std::string &source, BaseNode::ConversionContext *ctx){
+    if ( !ctx || !ctx->flatInstances )
+        return false;
 
-    if (isThis){
-        *compose << ")(this)";
-    } else {
-        *compose << ")(null)";
+    for ( BaseNode* instance : instances ){
+        if ( !instance->isNodeType<NewComponentExpressionNode>() )
+            return false;
+        std::string_view instanceSource = sliceView(source, instance);
+        if ( containsWord(instanceSource, "this") || containsWord(instanceSource, "arguments") )
+            return false;
     }
+    return true;
+}
 
-    *compose << ")\n";
+/**
+ * \brief Writes each of \p instances as a local temporary followed by a block that sets it up
+ *
+ * Returns the comma separated list of temporaries, in the order the instances were declared.
+ */
+std::string LanguageNodesToJs::convertFlatInstances(const std::vector<BaseNode *> &instances, const std::string &source, int indt, BaseNode::ConversionContext *ctx, ElementsInsertion *compose){
+    std::string parentSelf = m_self;
+    std::string references;
+
+    for ( BaseNode* instance : instances ){
+        NewComponentExpressionNode* node = instance->as<NewComponentExpressionNode>();
+        std::string self = "__c" + std::to_string(m_flatInstanceIndex++);
+
+        *compose << indent(indt) << "let " << self << " = " << newInstanceExpression(node, source) << "\n"
+                 << indent(indt) << "{\n"
+                 << indent(indt + 1) << "let parent = " << parentSelf << "\n"
+                 << indent(indt + 1) << self << ".setParent(parent)\n";
+
+        m_self = self;
+        convertNewComponentBody(node, source, indt, ctx, compose);
+        m_self = parentSelf;
+
+        *compose << indent(indt) << "}\n";
+
+        if ( !references.empty() )
+            references += ", ";
+        references += self;
+    }
+    return references;
+}
 
-    sections.push_back(compose);
+bool LanguageNodesToJs::containsWord(std::string_view text, std::string_view word){
+    auto isIdentifierChar = [](char c){
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+    };
+    size_t pos = text.find(word);
+    while ( pos != std::string_view::npos ){
+        size_t end = pos + word.size();
+        if ( (pos == 0 || !isIdentifierChar(text[pos - 1])) && (end == text.size() || !isIdentifierChar(text[end])) )
+            return true;
+        pos = text.find(word, pos + 1);
+    }
+    return false;
 }
 
 
@@ -1049,7 +1230,7 @@ void LanguageNodesToJs::convertNewTaggedComponentExpression(NewTaggedComponentEx
     *compose << indent(indentValue + 1) << "this.setParent(parent)\n";
     *compose << indent(indentValue + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".complete(this)\n";
     *compose << indent(indentValue + 1) << "return this\n";
-    *compose << indent(indentValue + 0) << "}.bind(new " << name << "(\"" << value << "\"))(this))\n";
+    *compose << indent(indentValue + 0) << "}.bind(new " << name << "(\"" << value << "\"))(" << m_self << "))\n";
 
     sections.push_back(compose);
 }
@@ -1091,7 +1272,7 @@ void LanguageNodesToJs::convertNewTrippleTaggedComponentExpression(NewTrippleTag
     *compose << indent(indentValue + 1) << "this.setParent(parent)\n";
     *compose << indent(indentValue + 1) << BaseNode::ConversionContext::baseComponentName(ctx) << ".complete(this)\n";
     *compose << indent(indentValue + 1) << "return this\n";
-    *compose << indent(indentValue + 0) << "}.bind(new " << name << "(\"" << value << "\"))(this))\n";
+    *compose << indent(indentValue + 0) << "}.bind(new " << name << "(\"" << value << "\"))(" << m_self << "))\n";
 
     sections.push_back(compose);
 }
@@ -1116,10 +1297,10 @@ void LanguageNodesToJs::convertVariableDeclaration(
         const auto declarator = variableDecl->declarators()[i];
         if (i != 0)
             *compose << ",";
-        *compose << slice(source, declarator->name());
+        *compose << sliceView(source, declarator->name());
 
         if (ctx->outputTypes && declarator->type()) {
-            *compose << slice(source, declarator->type());
+            *compose << sliceView(source, declarator->type());
         }
 
         if (declarator->value()) {
@@ -1287,9 +1468,18 @@ void LanguageNodesToJs::convertFunction(
 
 
 void LanguageNodesToJs::convertPropertyDeclaration(PropertyDeclarationNode *node, const std::string &source, const std::string &componentReference, int indt, BaseNode::ConversionContext *ctx, const PropertyAccessorDeclarationNode::PropertyAccess &propertyAccess, ElementsInsertion *compose){
-    *compose << indent(indt) << BaseNode::ConversionContext::baseComponentName(ctx) << ".addProperty(" + componentReference + ", '" << slice(source, node->name())
-             << "', { type: '" << (node->type() ? slice(source, node->type()) : "") << "', notify: '"
-             << slice(source, node->name()) << "Changed'";
+    *compose << indent(indt) << BaseNode::ConversionContext::baseComponentName(ctx) << ".addProperty(" + componentReference + ", '" << sliceView(source, node->name())
+             << "', ";
+    convertPropertyDescriptor(node, source, indt, ctx, propertyAccess, compose);
+    *compose << ")\n";
+}
+
+/**
+ * \brief Writes the descriptor object passed to \c addProperty for \p node
+ */
+void LanguageNodesToJs::convertPropertyDescriptor(PropertyDeclarationNode *node, const std::string &source, int indt, BaseNode::ConversionContext *ctx, const PropertyAccessorDeclarationNode::PropertyAccess &propertyAccess, ElementsInsertion *compose){
+    *compose << "{ type: '" << (node->type() ? sliceView(source, node->type()) : std::string_view()) << "', notify: '"
+             << sliceView(source, node->name()) << "Changed'";
 
     if ( propertyAccess.getter ){
         *compose << ", get: function()";
@@ -1297,29 +1487,28 @@ void LanguageNodesToJs::convertPropertyDeclaration(PropertyDeclarationNode *node
         jssection->from = propertyAccess.getter->body()->startByte();
         jssection->to   = propertyAccess.getter->body()->endByte();
         convert(propertyAccess.getter->body(), source, jssection->m_children, indt + 1, ctx);
-        std::vector<std::string> flat;
+        OutputBuffer flat;
         jssection->flatten(source, flat);
-        for (auto s: flat){
-            *compose << s << "\n";
+        for ( const OutputBuffer::Span& s : flat.parts() ){
+            *compose << std::string(s.data, s.size) << "\n";
         }
         delete jssection;
     }
     if ( propertyAccess.setter ){
-        *compose << ", set: function(" << (propertyAccess.setter->firstParameterName() ? slice(source, propertyAccess.setter->firstParameterName()) : "") << ")";
+        *compose << ", set: function(" << (propertyAccess.setter->firstParameterName() ? sliceView(source, propertyAccess.setter->firstParameterName()) : std::string_view()) << ")";
         JSSection* jssection = new JSSection;
         jssection->from = propertyAccess.setter->body()->startByte();
         jssection->to   = propertyAccess.setter->body()->endByte();
         convert(propertyAccess.setter->body(), source, jssection->m_children, indt + 1, ctx);
-        std::vector<std::string> flat;
+        OutputBuffer flat;
         jssection->flatten(source, flat);
-        for (auto s: flat){
-            *compose << s << "\n";
+        for ( const OutputBuffer::Span& s : flat.parts() ){
+            *compose << std::string(s.data, s.size) << "\n";
         }
         delete jssection;
     }
 
-
-    *compose << "})\n";
+    *compose << "}";
 }
 
 }} // namespace lv, el
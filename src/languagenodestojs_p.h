@@ -3,15 +3,35 @@
 
 #include "languagenodes_p.h"
 
+#include <map>
+
 namespace lv{ namespace el{
 
+/**
+ * \brief Converted js of a top level program node, with the range of flat instance names it took
+ */
+class ConvertedExport{
+public:
+    std::string js;
+    size_t      flatInstanceStart;
+    size_t      flatInstanceEnd;
+};
+
 class LanguageNodesToJs{
 
+public:
+    /** Converted js of top level program nodes */
+    typedef std::map<BaseNode*, ConvertedExport> ExportOutput;
+
 public:
     LanguageNodesToJs();
 
+    void setExportOutput(ExportOutput* exportOutput){ m_exportOutput = exportOutput; }
+
     static std::string slice(const std::string& source, uint32_t start, uint32_t end);
     static std::string slice(const std::string& source, BaseNode* node);
+    static std::string_view sliceView(const std::string& source, uint32_t start, uint32_t end);
+    static std::string_view sliceView(const std::string& source, BaseNode* node);
     static bool newLineFollows(const std::string& source, size_t startPosition);
     static bool newLinePrecedes(const std::string& source, size_t endPosition);
 
@@ -106,10 +126,48 @@ public:
         ElementsInsertion *compose
     );
 
+    void convertPropertyDescriptor(
+        PropertyDeclarationNode* node,
+        const std::string& source,
+        int indt,
+        BaseNode::ConversionContext* ctx,
+        const PropertyAccessorDeclarationNode::PropertyAccess& propertyAccess,
+        ElementsInsertion *compose
+    );
+
 
 private:
-    static std::string indent(int i);
+    std::string indent(int i) const;
+    static bool containsWord(std::string_view text, std::string_view word);
+
+    void convertNewComponentBody(
+        NewComponentExpressionNode* node,
+        const std::string& source,
+        int indt,
+        BaseNode::ConversionContext* ctx,
+        ElementsInsertion* compose
+    );
+    std::string newInstanceExpression(NewComponentExpressionNode* node, const std::string& source);
+    bool canFlattenInstances(const std::vector<BaseNode*>& instances, const std::string& source, BaseNode::ConversionContext* ctx);
+    std::string convertFlatInstances(
+        const std::vector<BaseNode*>& instances,
+        const std::string& source,
+        int indt,
+        BaseNode::ConversionContext* ctx,
+        ElementsInsertion* compose
+    );
 
+    /** \brief Checks whether a binding on \p property can be emitted as a plain assignment */
+    template<typename T> bool isStaticBinding(T* property, const std::string& source, BaseNode::ConversionContext* ctx){
+        return ctx && ctx->staticBindings && property->hasConstantBindings(source, *m_strings);
+    }
+
+    ExportOutput*       m_exportOutput;
+    StringInterner::Ptr m_strings;
+    /** Reference to the object whose body is currently being written */
+    std::string         m_self;
+    size_t              m_flatInstanceIndex;
+    bool                m_compact;
 };
 
 }} // namespace lv, el
@@ -87,14 +87,52 @@ std::string slice(const std::string& source, TSNode& node){
 LanguageParser::LanguageParser(Language *language)
     : m_parser(ts_parser_new())
     , m_language(language)
+    , m_totalLeasedParsers(0)
 {
     ts_parser_set_language(m_parser, reinterpret_cast<const TSLanguage*>(language));
 }
 
 LanguageParser::~LanguageParser(){
+    for ( auto it = m_idleParsers.begin(); it != m_idleParsers.end(); ++it ){
+        ts_parser_delete(*it);
+    }
     ts_parser_delete(m_parser);
 }
 
+/**
+ * \brief Leases a parser for the calling thread
+ *
+ * A TSParser cannot be used by two threads at once, so every parse takes an idle parser
+ * from this object, or creates a new one for the same language when all are in use. The
+ * language itself is immutable and shared by all of them.
+ */
+TSParser *LanguageParser::acquireParser() const{
+    std::lock_guard<std::mutex> guard(m_idleParsersMutex);
+    if ( !m_idleParsers.empty() ){
+        TSParser* parser = m_idleParsers.back();
+        m_idleParsers.pop_back();
+        return parser;
+    }
+
+    TSParser* parser = ts_parser_new();
+    ts_parser_set_language(parser, reinterpret_cast<const TSLanguage*>(m_language));
+    ++m_totalLeasedParsers;
+    return parser;
+}
+
+void LanguageParser::releaseParser(TSParser *parser) const{
+    std::lock_guard<std::mutex> guard(m_idleParsersMutex);
+    m_idleParsers.push_back(parser);
+}
+
+/**
+ * \brief Number of parsers created so far for concurrent parsing
+ */
+size_t LanguageParser::totalLeasedParsers() const{
+    std::lock_guard<std::mutex> guard(m_idleParsersMutex);
+    return m_totalLeasedParsers;
+}
+
 LanguageParser::Ptr LanguageParser::create(LanguageParser::Language *language){
     return LanguageParser::Ptr(new LanguageParser(language));
 }
@@ -108,7 +146,9 @@ void LanguageParser::editParseTree(LanguageParser::AST*& ast, TSInputEdit& edit,
         ts_tree_edit(tree, &edit);
 
     }
-    TSTree* new_tree = ts_parser_parse(m_parser, tree, input);
+    TSParser* parser = acquireParser();
+    TSTree* new_tree = ts_parser_parse(parser, tree, input);
+    releaseParser(parser);
 
     ast = reinterpret_cast<el::LanguageParser::AST*>(new_tree);
 
@@ -119,7 +159,30 @@ LanguageParser::Ptr LanguageParser::createForElements(){
 }
 
 LanguageParser::AST *LanguageParser::parse(const std::string &source) const{
-    return reinterpret_cast<LanguageParser::AST*>(ts_parser_parse_string(m_parser, nullptr, source.c_str(), static_cast<uint32_t>(source.size())));
+    TSParser* parser = acquireParser();
+    TSTree* tree = ts_parser_parse_string(parser, nullptr, source.c_str(), static_cast<uint32_t>(source.size()));
+    releaseParser(parser);
+    return reinterpret_cast<LanguageParser::AST*>(tree);
+}
+
+/**
+ * \brief Applies \p edits to \p ast and parses \p input reusing its unchanged nodes
+ *
+ * The edited \p ast stays valid and is still owned by the caller, so it can be compared
+ * against the returned tree.
+ */
+LanguageParser::AST *LanguageParser::reparse(LanguageParser::AST *ast, const std::string &input, const std::vector<TSInputEdit> &edits) const{
+    TSTree* tree = reinterpret_cast<TSTree*>(ast);
+    if ( tree ){
+        for ( const TSInputEdit& edit : edits ){
+            ts_tree_edit(tree, &edit);
+        }
+    }
+
+    TSParser* parser = acquireParser();
+    TSTree* result = ts_parser_parse_string(parser, tree, input.c_str(), static_cast<uint32_t>(input.size()));
+    releaseParser(parser);
+    return reinterpret_cast<LanguageParser::AST*>(result);
 }
 
 void LanguageParser::destroy(LanguageParser::AST *ast) const{
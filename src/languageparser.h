@@ -24,6 +24,7 @@
 #include <string>
 #include <list>
 #include <vector>
+#include <mutex>
 
 struct TSParser;
 
@@ -121,6 +122,7 @@ public:
     static Ptr createForElements();
 
     AST* parse(const std::string& input) const;
+    AST* reparse(AST* ast, const std::string& input, const std::vector<TSInputEdit>& edits) const;
     void editParseTree(LanguageParser::AST*& ast, TSInputEdit& edit, TSInput& input);
     void destroy(AST* ast) const;
     ComparisonResult compare(const std::string& source1, AST* ast1, const std::string& source2, AST* ast2);
@@ -132,7 +134,12 @@ public:
     TSParser* internal() const{ return m_parser; }
     Language* language() const;
 
+    size_t totalLeasedParsers() const;
+
 private:
+    TSParser* acquireParser() const;
+    void releaseParser(TSParser* parser) const;
+
     std::list<std::string> parseExportNamesJs(const std::string& jsModuleFile);
 
     LanguageParser(Language* language);
@@ -142,6 +149,10 @@ private:
 
     TSParser* m_parser;
     Language* m_language;
+
+    mutable std::mutex             m_idleParsersMutex;
+    mutable std::vector<TSParser*> m_idleParsers;
+    mutable size_t                 m_totalLeasedParsers;
 };
 
 }} // namespace lv, el
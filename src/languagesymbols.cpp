@@ -0,0 +1,166 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "languagesymbols_p.h"
+#include "elementsparserinternal.h"
+
+#include <string.h>
+
+namespace lv{ namespace el{
+
+namespace{
+
+const char* symbolNames[LanguageSymbols::TotalSymbols] = {
+    "",
+    "ERROR",
+    "import_statement",
+    "js_import_statement",
+    "import_as",
+    "import_path",
+    "import_path_segment",
+    "identifier",
+    "nested_identifier",
+    "property_identifier",
+    "shorthand_property_identifier",
+    "component_identifier",
+    "component",
+    "component_declaration",
+    "component_heritage",
+    "component_short_heritage",
+    "component_body",
+    "component_instance",
+    "component_instance_statement",
+    "new_component_expression",
+    "nested_new_component_expression",
+    "new_component_body",
+    "new_tagged_component_expression",
+    "tagged_type_string",
+    "new_tripple_tagged_component_expression",
+    "tripple_tagged_type_string",
+    "constructor_definition",
+    "class_declaration",
+    "property_declaration",
+    "static_property_declaration",
+    "property_assignment",
+    "identifier_property_assignment",
+    "property_assignment_expression",
+    "property_expression_initializer",
+    "property_accessor_declaration",
+    "event_declaration",
+    "listener_declaration",
+    "method_definition",
+    "typed_method_declaration",
+    "typed_function_declaration",
+    "function_declaration",
+    "function",
+    "arrow_function",
+    "formal_parameters",
+    "required_parameter",
+    "optional_parameter",
+    "formal_type_parameters",
+    "formal_type_parameter",
+    "required_type_parameter",
+    "optional_type_parameter",
+    "type_annotation",
+    "statement_block",
+    "expression_statement",
+    "return_statement",
+    "try_statement",
+    "catch_clause",
+    "finally_clause",
+    "variable_declaration",
+    "lexical_declaration",
+    "variable_declarator",
+    "array_pattern",
+    "object_pattern",
+    "assignment_expression",
+    "call_expression",
+    "new_expression",
+    "member_expression",
+    "subscript_expression",
+    "arguments",
+    "object",
+    "number",
+    "string",
+    "this",
+    "super",
+    "async",
+    "static",
+    "get",
+    "set",
+    "const",
+    "import",
+    "on",
+    ".",
+    "=",
+    ";",
+    "{",
+    "}"
+};
+
+const char* fieldNames[LanguageSymbols::TotalFields] = {
+    "body",
+    "heritage",
+    "id",
+    "kind",
+    "left",
+    "name",
+    "parameter",
+    "parameters",
+    "pattern",
+    "relative",
+    "return_type",
+    "right",
+    "type",
+    "value"
+};
+
+} // namespace
+
+LanguageSymbols::LanguageSymbols(const TSLanguage *language)
+    : m_symbols(ts_language_symbol_count(language), Unknown)
+{
+    for ( size_t i = 0; i < m_symbols.size(); ++i ){
+        const char* name = ts_language_symbol_name(language, static_cast<TSSymbol>(i));
+        if ( !name )
+            continue;
+        for ( int s = 1; s < TotalSymbols; ++s ){
+            if ( strcmp(name, symbolNames[s]) == 0 ){
+                m_symbols[i] = static_cast<unsigned char>(s);
+                break;
+            }
+        }
+    }
+
+    for ( int f = 0; f < TotalFields; ++f ){
+        m_fields[f] = ts_language_field_id_for_name(language, fieldNames[f], static_cast<uint32_t>(strlen(fieldNames[f])));
+    }
+}
+
+const LanguageSymbols &LanguageSymbols::elements(){
+    static LanguageSymbols symbols(tree_sitter_elements());
+    return symbols;
+}
+
+const char *LanguageSymbols::symbolName(LanguageSymbols::Symbol symbol){
+    return symbolNames[symbol];
+}
+
+const char *LanguageSymbols::fieldName(LanguageSymbols::Field field){
+    return fieldNames[field];
+}
+
+}} // namespace lv, el
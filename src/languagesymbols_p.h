@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVLANGUAGESYMBOLS_H
+#define LVLANGUAGESYMBOLS_H
+
+#include "tree_sitter/api.h"
+
+#include <vector>
+
+namespace lv{ namespace el{
+
+/**
+ * \class LanguageSymbols
+ * \brief Grammar symbol and field ids of the elements language, resolved once by name.
+ *
+ * Node types are compared through Symbol values looked up by the node's symbol id, which
+ * replaces comparing ts_node_type strings. A name shared by a named node and an anonymous
+ * token (e.g. "function") maps both ids to the same Symbol, same as the string comparison.
+ */
+class LanguageSymbols{
+
+public:
+    enum Symbol{
+        Unknown = 0,
+        Error,
+        ImportStatement,
+        JsImportStatement,
+        ImportAs,
+        ImportPath,
+        ImportPathSegment,
+        Identifier,
+        NestedIdentifier,
+        PropertyIdentifier,
+        ShorthandPropertyIdentifier,
+        ComponentIdentifier,
+        Component,
+        ComponentDeclaration,
+        ComponentHeritage,
+        ComponentShortHeritage,
+        ComponentBody,
+        ComponentInstance,
+        ComponentInstanceStatement,
+        NewComponentExpression,
+        NestedNewComponentExpression,
+        NewComponentBody,
+        NewTaggedComponentExpression,
+        TaggedTypeString,
+        NewTrippleTaggedComponentExpression,
+        TrippleTaggedTypeString,
+        ConstructorDefinition,
+        ClassDeclaration,
+        PropertyDeclaration,
+        StaticPropertyDeclaration,
+        PropertyAssignment,
+        IdentifierPropertyAssignment,
+        PropertyAssignmentExpression,
+        PropertyExpressionInitializer,
+        PropertyAccessorDeclaration,
+        EventDeclaration,
+        ListenerDeclaration,
+        MethodDefinition,
+        TypedMethodDeclaration,
+        TypedFunctionDeclaration,
+        FunctionDeclaration,
+        Function,
+        ArrowFunction,
+        FormalParameters,
+        RequiredParameter,
+        OptionalParameter,
+        FormalTypeParameters,
+        FormalTypeParameter,
+        RequiredTypeParameter,
+        OptionalTypeParameter,
+        TypeAnnotation,
+        StatementBlock,
+        ExpressionStatement,
+        ReturnStatement,
+        TryStatement,
+        CatchClause,
+        FinallyClause,
+        VariableDeclaration,
+        LexicalDeclaration,
+        VariableDeclarator,
+        ArrayPattern,
+        ObjectPattern,
+        AssignmentExpression,
+        CallExpression,
+        NewExpression,
+        MemberExpression,
+        SubscriptExpression,
+        Arguments,
+        Object,
+        Number,
+        String,
+        This,
+        Super,
+        Async,
+        Static,
+        Get,
+        Set,
+        Const,
+        Import,
+        On,
+        Dot,
+        Equals,
+        Semicolon,
+        OpenBrace,
+        CloseBrace,
+        TotalSymbols
+    };
+
+    enum Field{
+        FieldBody,
+        FieldHeritage,
+        FieldId,
+        FieldKind,
+        FieldLeft,
+        FieldName,
+        FieldParameter,
+        FieldParameters,
+        FieldPattern,
+        FieldRelative,
+        FieldReturnType,
+        FieldRight,
+        FieldType,
+        FieldValue,
+        TotalFields
+    };
+
+public:
+    static const LanguageSymbols& elements();
+
+    Symbol symbol(const TSNode& node) const;
+    TSFieldId fieldId(Field field) const;
+    TSNode childByField(const TSNode& node, Field field) const;
+
+    static const char* symbolName(Symbol symbol);
+    static const char* fieldName(Field field);
+
+private:
+    LanguageSymbols(const TSLanguage* language);
+
+    std::vector<unsigned char> m_symbols;
+    TSFieldId                  m_fields[TotalFields];
+};
+
+inline LanguageSymbols::Symbol LanguageSymbols::symbol(const TSNode &node) const{
+    TSSymbol s = ts_node_symbol(node);
+    if ( s == static_cast<TSSymbol>(-1) )
+        return Error;
+    return s < m_symbols.size() ? static_cast<Symbol>(m_symbols[s]) : Unknown;
+}
+
+inline TSFieldId LanguageSymbols::fieldId(LanguageSymbols::Field field) const{
+    return m_fields[field];
+}
+
+inline TSNode LanguageSymbols::childByField(const TSNode &node, LanguageSymbols::Field field) const{
+    return ts_node_child_by_field_id(node, m_fields[field]);
+}
+
+}} // namespace lv, el
+
+#endif // LVLANGUAGESYMBOLS_H
@@ -0,0 +1,293 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+
+#include "modulebundle_p.h"
+#include "live/exception.h"
+
+namespace lv{ namespace el{
+
+namespace{
+
+bool isSpace(char c){
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool isIdentifierChar(char c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+size_t skipSpaces(const std::string& text, size_t position){
+    while ( position < text.size() && isSpace(text[position]) )
+        ++position;
+    return position;
+}
+
+std::string join(const std::list<std::string>& names){
+    std::string result;
+    for ( const std::string& name : names ){
+        if ( !result.empty() )
+            result += ", ";
+        result += name;
+    }
+    return result;
+}
+
+} // namespace
+
+ModuleBundle::ModuleBundle(){
+}
+
+/**
+ * \brief Adds the output of \p file to the bundle
+ */
+void ModuleBundle::addFile(const ModuleBundle::File &file){
+    m_files.push_back(file);
+}
+
+/**
+ * \brief Writes the bundle, ordering the files so each one follows the files it imports
+ *
+ * The imports at the start of each output are replaced by local declarations. Throws if files
+ * of the bundle import each other.
+ */
+std::string ModuleBundle::toString() const{
+    std::map<std::string, size_t> filesByPath;
+    for ( size_t i = 0; i < m_files.size(); ++i )
+        filesByPath[m_files[i].importPath] = i;
+
+    std::vector<std::vector<Import> > imports(m_files.size());
+    std::vector<size_t> bodyStarts(m_files.size(), 0);
+    for ( size_t i = 0; i < m_files.size(); ++i ){
+        size_t position = 0;
+        while ( true ){
+            Import import;
+            size_t next = readImport(m_files[i].output, position, import);
+            if ( next == std::string::npos )
+                break;
+            position = next;
+            imports[i].push_back(import);
+        }
+        bodyStarts[i] = position;
+    }
+
+    // depth first over local imports, reaching a file that is still being visited means a cycle
+    enum VisitState{ NotVisited = 0, Visiting, Visited };
+    std::vector<VisitState> states(m_files.size(), NotVisited);
+    std::vector<size_t> order;
+    for ( size_t root = 0; root < m_files.size(); ++root ){
+        if ( states[root] != NotVisited )
+            continue;
+        states[root] = Visiting;
+        std::vector<std::pair<size_t, size_t> > stack = {std::make_pair(root, size_t(0))};
+        while ( !stack.empty() ){
+            size_t index = stack.back().first;
+            size_t importIndex = stack.back().second++;
+            if ( importIndex == imports[index].size() ){
+                states[index] = Visited;
+                order.push_back(index);
+                stack.pop_back();
+                continue;
+            }
+
+            auto it = filesByPath.find(imports[index][importIndex].path);
+            if ( it == filesByPath.end() || states[it->second] == Visited )
+                continue;
+            if ( states[it->second] == Visiting ){
+                THROW_EXCEPTION(
+                    lv::Exception,
+                    "Cannot bundle files that import each other: " + m_files[index].importPath + ", " + it->first,
+                    lv::Exception::toCode("~Import")
+                );
+            }
+            states[it->second] = Visiting;
+            stack.push_back(std::make_pair(it->second, size_t(0)));
+        }
+    }
+
+    std::map<std::string, std::map<std::string, std::string> > externalImports;
+    size_t aliasIndex = 0;
+    std::list<std::string> exports;
+    std::string body;
+
+    for ( size_t index : order ){
+        const File& file = m_files[index];
+
+        std::string scope;
+        for ( const Import& import : imports[index] ){
+            bool isLocal = filesByPath.find(import.path) != filesByPath.end();
+            for ( const auto& name : import.names ){
+                if ( isLocal ){
+                    if ( name.first != name.second )
+                        scope += "const " + name.second + " = " + name.first + "\n";
+                } else {
+                    std::string& alias = externalImports[import.path][name.first];
+                    if ( alias.empty() )
+                        alias = "__b" + std::to_string(aliasIndex++);
+                    scope += "const " + name.second + " = " + alias + "\n";
+                }
+            }
+        }
+
+        std::string exportList = join(file.exports);
+        body += exportList.empty() ? "(function(){\n" : "const {" + exportList + "} = (function(){\n";
+        body += scope;
+        body += removeExports(file.output.substr(bodyStarts[index]), file.exports);
+        if ( !exportList.empty() )
+            body += "\nreturn {" + exportList + "}";
+        body += "\n})()\n";
+
+        exports.insert(exports.end(), file.exports.begin(), file.exports.end());
+    }
+
+    std::string result;
+    for ( auto pathIt = externalImports.begin(); pathIt != externalImports.end(); ++pathIt ){
+        std::string names;
+        for ( auto nameIt = pathIt->second.begin(); nameIt != pathIt->second.end(); ++nameIt ){
+            if ( !names.empty() )
+                names += ", ";
+            names += nameIt->first + " as " + nameIt->second;
+        }
+        result += "import {" + names + "} from '" + pathIt->first + "'\n";
+    }
+
+    result += body;
+
+    if ( !exports.empty() )
+        result += "export {" + join(exports) + "}\n";
+    return result;
+}
+
+/**
+ * \brief Reads the import statement at \p position into \p import
+ *
+ * Only the forms the compiler writes are recognized: named imports, with optional aliases, and
+ * default imports. Returns the position after the statement, or \c npos if there's no import
+ * at \p position.
+ */
+size_t ModuleBundle::readImport(const std::string &output, size_t position, ModuleBundle::Import &import){
+    const std::string keyword = "import";
+    position = skipSpaces(output, position);
+    if ( output.compare(position, keyword.size(), keyword) != 0 )
+        return std::string::npos;
+    position += keyword.size();
+    if ( position >= output.size() || (!isSpace(output[position]) && output[position] != '{') )
+        return std::string::npos;
+    position = skipSpaces(output, position);
+
+    if ( position < output.size() && output[position] == '{' ){
+        size_t end = output.find('}', position);
+        if ( end == std::string::npos )
+            return std::string::npos;
+
+        std::string specifiers = output.substr(position + 1, end - position - 1);
+        size_t start = 0;
+        while ( start < specifiers.size() ){
+            size_t comma = specifiers.find(',', start);
+            if ( comma == std::string::npos )
+                comma = specifiers.size();
+
+            std::vector<std::string> words;
+            size_t wordStart = skipSpaces(specifiers, start);
+            while ( wordStart < comma ){
+                size_t wordEnd = wordStart;
+                while ( wordEnd < comma && isIdentifierChar(specifiers[wordEnd]) )
+                    ++wordEnd;
+                if ( wordEnd == wordStart )
+                    return std::string::npos;
+                words.push_back(specifiers.substr(wordStart, wordEnd - wordStart));
+                wordStart = skipSpaces(specifiers, wordEnd);
+            }
+
+            if ( words.size() == 1 ){
+                import.names.push_back(std::make_pair(words[0], words[0]));
+            } else if ( words.size() == 3 && words[1] == "as" ){
+                import.names.push_back(std::make_pair(words[0], words[2]));
+            } else if ( !words.empty() ){
+                return std::string::npos;
+            }
+            start = comma + 1;
+        }
+        position = end + 1;
+    } else {
+        size_t end = position;
+        while ( end < output.size() && isIdentifierChar(output[end]) )
+            ++end;
+        if ( end == position )
+            return std::string::npos;
+        import.names.push_back(std::make_pair(std::string("default"), output.substr(position, end - position)));
+        position = end;
+    }
+
+    position = skipSpaces(output, position);
+    if ( output.compare(position, 4, "from") != 0 )
+        return std::string::npos;
+    position = skipSpaces(output, position + 4);
+
+    if ( position >= output.size() || (output[position] != '\'' && output[position] != '"') )
+        return std::string::npos;
+    size_t pathEnd = output.find(output[position], position + 1);
+    if ( pathEnd == std::string::npos )
+        return std::string::npos;
+    import.path = output.substr(position + 1, pathEnd - position - 1);
+
+    position = pathEnd + 1;
+    if ( position < output.size() && output[position] == ';' )
+        ++position;
+    return position;
+}
+
+/**
+ * \brief Removes the export keyword from the top level declarations of \p exports
+ */
+std::string ModuleBundle::removeExports(const std::string &output, const std::list<std::string> &exports){
+    static const std::string exportKeyword = "export ";
+    static const std::string declarations[] = { "class ", "let " };
+
+    std::string result;
+    result.reserve(output.size());
+
+    size_t last = 0;
+    size_t position = output.find(exportKeyword);
+    while ( position != std::string::npos ){
+        if ( position == 0 || output[position - 1] == '\n' ){
+            for ( const std::string& declaration : declarations ){
+                size_t nameStart = position + exportKeyword.size();
+                if ( output.compare(nameStart, declaration.size(), declaration) != 0 )
+                    continue;
+                nameStart += declaration.size();
+                size_t nameEnd = nameStart;
+                while ( nameEnd < output.size() && isIdentifierChar(output[nameEnd]) )
+                    ++nameEnd;
+
+                std::string name = output.substr(nameStart, nameEnd - nameStart);
+                for ( const std::string& exp : exports ){
+                    if ( exp == name ){
+                        result.append(output, last, position - last);
+                        last = position + exportKeyword.size();
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        position = output.find(exportKeyword, position + exportKeyword.size());
+    }
+    result.append(output, last, std::string::npos);
+    return result;
+}
+
+}} // namespace lv, el
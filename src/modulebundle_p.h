@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVMODULEBUNDLE_H
+#define LVMODULEBUNDLE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+
+namespace lv{ namespace el{
+
+/**
+ * \class ModuleBundle
+ * \brief Joins the js output of the files of a module into a single es module
+ *
+ * Each file is wrapped in its own function scope, so names private to a file can't clash.
+ * Imports between files of the bundle become local references, imports from outside the bundle
+ * are merged at the top, and the exports of all files are exported again at the end. Files are
+ * written after the files they import, whatever order they were added in.
+ */
+class ModuleBundle{
+
+public:
+    class File{
+    public:
+        /** Path other files of the bundle import this file through, e.g. ./A.lv.js */
+        std::string            importPath;
+        std::string            output;
+        std::list<std::string> exports;
+    };
+
+    class Import{
+    public:
+        std::string path;
+        /** Pairs of imported and local names, default imports use the name default */
+        std::vector<std::pair<std::string, std::string> > names;
+    };
+
+public:
+    ModuleBundle();
+
+    void addFile(const File& file);
+    std::string toString() const;
+
+    static size_t readImport(const std::string& output, size_t position, Import& import);
+    static std::string removeExports(const std::string& output, const std::list<std::string>& exports);
+
+private:
+    std::vector<File> m_files;
+};
+
+}} // namespace lv, el
+
+#endif // LVMODULEBUNDLE_H
@@ -15,6 +15,10 @@
 
 #include "modulefile.h"
 #include "languagenodes_p.h"
+#include "languagenodestojs_p.h"
+#include "compilecache_p.h"
+#include "compilertrace_p.h"
+#include "dependencycycles_p.h"
 #include "live/elements/compiler/languageparser.h"
 #include "live/exception.h"
 #include "live/module.h"
@@ -23,15 +27,67 @@
 #include "live/visuallog.h"
 
 #include <sstream>
+#include <map>
+#include <iterator>
+#include <algorithm>
+#include <unordered_map>
+#include <stdlib.h>
 
 namespace lv{ namespace el{
 
+namespace{
+
+bool intersectsRanges(const std::vector<TSRange>& ranges, uint32_t start, uint32_t end){
+    for ( const TSRange& range : ranges ){
+        if ( start < range.end_byte && range.start_byte < end )
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Maps a range of the edited content back to the content before \p edits, shifting ranges
+ * that follow an edit by the size it changed. Returns false if any of the edits touches the
+ * range.
+ */
+bool mapRangeBeforeEdits(const std::vector<TSInputEdit>& edits, uint32_t& start, uint32_t& end){
+    for ( auto it = edits.rbegin(); it != edits.rend(); ++it ){
+        if ( end <= it->start_byte )
+            continue;
+        if ( start < it->new_end_byte )
+            return false;
+        start = start - it->new_end_byte + it->old_end_byte;
+        end   = end - it->new_end_byte + it->old_end_byte;
+    }
+    return true;
+}
+
+} // namespace
+
 class ModuleFilePrivate{
 public:
     std::string name;
+    /** File names and paths, computed once since the module and build paths do not change */
+    std::string fileName;
+    std::string jsFileName;
+    std::string filePath;
+    std::string jsFilePath;
     std::string content;
-    ElementsModule::Ptr elementsModule;
+    /** The module owns its files, so files only keep a weak reference back to it */
+    ElementsModule* elementsModule;
+    std::weak_ptr<ElementsModule> elementsModuleRef;
     ProgramNode* rootNode;
+    LanguageParser::AST* ast;
+    bool astMatchesNodes;
+    LanguageNodesToJs::ExportOutput exportOutput;
+    ProgramNode::ImportTypeMap importTypes;
+    StringInterner::Ptr strings;
+    bool hasCachedOutput;
+    bool isInterfaceOnly;
+    std::string cachedOutput;
+    std::string cachedResolutionHash;
+    /** Output of the last compile, kept only while the module is bundled */
+    std::string compiledOutput;
     ModuleFile::CompilationData* compilationData;
 
     ModuleFile::State state;
@@ -40,79 +96,54 @@ public:
     std::list<ModuleFile::Import> imports;
     std::list<ModuleFile*> dependencies;
     std::list<ModuleFile*> dependents;
+    /** Files from imported modules that this file uses types from */
+    std::list<ModuleFile*> importedFiles;
+    bool isReachable;
+    bool isReleased;
+    /** Hash of the content that was dropped by release() */
+    std::string releasedContentHash;
 };
 
 ModuleFile::~ModuleFile(){
     delete m_d->compilationData;
+    delete m_d->rootNode;
+    m_d->elementsModule->compiler()->parser()->destroy(m_d->ast);
     delete m_d;
 }
 
 void ModuleFile::resolveTypes(){
-    auto impTypes = m_d->rootNode->importTypes();
-    for ( auto nsit = impTypes.begin(); nsit != impTypes.end(); ++nsit ){
+    LV_COMPILER_TRACE_SPAN("resolveTypes", filePath());
+
+    // imports by namespace, several imports can share one
+    std::unordered_map<std::string, std::vector<const ModuleFile::Import*> > importsByNamespace;
+    for ( const ModuleFile::Import& imp : m_d->imports ){
+        if ( imp.module )
+            importsByNamespace[imp.as].push_back(&imp);
+    }
+
+    for ( auto nsit = m_d->importTypes.begin(); nsit != m_d->importTypes.end(); ++nsit ){
+        auto namespaceImports = importsByNamespace.find(nsit->first.str());
+
         for ( auto it = nsit->second.begin(); it != nsit->second.end(); ++it ){
             ProgramNode::ImportType& impType = it->second;
             bool foundLocalExport = false;
             if ( impType.importNamespace.empty() ){
-                auto foundExp = m_d->elementsModule->findExport(impType.name);
+                auto foundExp = m_d->elementsModule->findExport(impType.name.str());
                 if ( foundExp.isValid() ){
                     addDependency(foundExp.file);
 
-                    m_d->rootNode->resolveImport(impType.importNamespace, impType.name, "./" + foundExp.file->jsFileName());
+                    impType.resolvedPath = "./" + foundExp.file->jsFileName();
                     foundLocalExport = true;
                 }
             }
 
-            if ( !foundLocalExport ){
-                for( auto impIt = m_d->imports.begin(); impIt != m_d->imports.end(); ++impIt ){
-                    if ( impIt->as == impType.importNamespace ){
-                        auto foundExp = impIt->module->findExport(impType.name);
-                        if ( foundExp.isValid() ){
-                            if ( impIt->isRelative ){
-                                // this plugin to package
-                                std::vector<Utf8> parts = Utf8(m_d->elementsModule->module()->context()->importId).split(".");
-                                if ( parts.size() > 0 ){
-                                    parts.erase(parts.begin());
-                                }
-
-                                std::string pluginToPackage = "";
-                                if ( parts.size() > 0 ){
-                                    for ( size_t i = 0; i < parts.size(); ++i ){
-                                        if ( !pluginToPackage.empty() )
-                                            pluginToPackage += '/';
-                                        pluginToPackage += "..";
-                                    }
-                                } else {
-                                    pluginToPackage = ".";
-                                }
-
-                                // package to new plugin
-
-                                std::vector<Utf8> packageToNewPluginParts = Utf8(impIt->module->module()->context()->importId).split(".");
-                                if ( packageToNewPluginParts.size() > 0 ){
-                                    packageToNewPluginParts.erase(packageToNewPluginParts.begin());
-                                }
-                                std::string packageToNewPlugin = Utf8::join(packageToNewPluginParts, "/").data();
-                                if ( !packageToNewPlugin.empty() )
-                                    packageToNewPlugin += "/";
-
-                                m_d->rootNode->resolveImport(impType.importNamespace, impType.name, pluginToPackage + "/" + packageToNewPlugin + foundExp.file->jsFileName());
-
-                            } else {
-                                std::vector<Utf8> packageToPlugin = impIt->module->module()->context()->importId.split(".");
-                                packageToPlugin.erase(packageToPlugin.begin());
-
-                                std::string configPackageBuildPath = m_d->elementsModule->compiler()->packageBuildPath();
-                                std::string packageBuildPath =
-                                    impIt->module->module()->context()->package->name() +
-                                    (configPackageBuildPath.empty() ? "" : "/" + configPackageBuildPath);
-                                std::string packageToPluginStr = Utf8::join(packageToPlugin, "/").data();
-                                std::string importPath = packageBuildPath + (packageToPluginStr.empty() ? "" : "/" + packageToPluginStr) + "/" + foundExp.file->jsFileName();
-
-                                m_d->rootNode->resolveImport(impType.importNamespace, impType.name, importPath);
-                            }
-                            break;
-                        }
+            if ( !foundLocalExport && namespaceImports != importsByNamespace.end() ){
+                for ( const ModuleFile::Import* imp : namespaceImports->second ){
+                    auto foundExp = imp->module->findExport(impType.name.str());
+                    if ( foundExp.isValid() ){
+                        m_d->importedFiles.push_back(foundExp.file);
+                        impType.resolvedPath = m_d->elementsModule->importPathPrefix(imp->module.get(), imp->isRelative) + foundExp.file->jsFileName();
+                        break;
                     }
                 }
             }
@@ -120,8 +151,220 @@ void ModuleFile::resolveTypes(){
     }
 }
 
+/**
+ * \brief Converts this file and writes its output
+ *
+ * With a compile cache, the cached output is used as long as the types resolve to the same
+ * paths, in which case the file is not parsed at all. Otherwise the file is converted and
+ * its entry is updated.
+ */
 void ModuleFile::compile(){
-    m_d->elementsModule->compiler()->compileModuleFileToJs(m_d->elementsModule->module(), filePath(), m_d->content, m_d->rootNode);
+    if ( m_d->isInterfaceOnly )
+        return;
+
+    LV_COMPILER_TRACE_SPAN("compileModuleFile", filePath());
+
+    Compiler::Ptr compiler = m_d->elementsModule->compiler();
+    const Module::Ptr& module = m_d->elementsModule->module();
+    CompileCache* cache = compiler->compileCache();
+
+    std::string resolution;
+    if ( cache ){
+        resolution = resolutionHash();
+        if ( m_d->hasCachedOutput && m_d->cachedResolutionHash == resolution ){
+            cache->addHit();
+            if ( compiler->config().moduleBundleEnabled() )
+                m_d->compiledOutput = m_d->cachedOutput;
+            if ( compiler->config().fileOutputEnabled() ){
+                compiler->writeModuleFileOutput(module, filePath(), m_d->cachedOutput, !Path::exists(jsFilePath()));
+            }
+            return;
+        }
+        cache->addMiss();
+    }
+
+    if ( m_d->isReleased )
+        rematerialize();
+    else if ( !m_d->rootNode )
+        parse();
+
+    for ( auto nsit = m_d->importTypes.begin(); nsit != m_d->importTypes.end(); ++nsit ){
+        for ( auto it = nsit->second.begin(); it != nsit->second.end(); ++it ){
+            m_d->rootNode->resolveImport(it->second.importNamespace.str(), it->second.name.str(), it->second.resolvedPath);
+        }
+    }
+
+    std::string output = compiler->convertModuleFile(module, filePath(), m_d->content, m_d->rootNode, &m_d->exportOutput);
+    if ( compiler->config().moduleBundleEnabled() )
+        m_d->compiledOutput = output;
+
+    if ( compiler->config().fileOutputEnabled() ){
+        bool shouldWrite = cache ? true : !compiler->isModuleFileOutputCurrent(module, filePath());
+        compiler->writeModuleFileOutput(module, filePath(), output, shouldWrite);
+    }
+
+    if ( cache ){
+        CompileCache::Entry entry;
+        entry.configHash = compiler->configHash();
+        entry.contentHash = CompileCache::hash(m_d->content);
+        entry.resolutionHash = resolution;
+        for ( const ModuleFile::Export& e : m_d->exports ){
+            CompileCache::Entry::Export cacheExport;
+            cacheExport.name = e.name;
+            cacheExport.isComponent = e.type == ModuleFile::Export::Component;
+            entry.exports.push_back(cacheExport);
+        }
+        for ( const ModuleFile::Import& i : m_d->imports ){
+            CompileCache::Entry::Import cacheImport;
+            cacheImport.uri = i.uri;
+            cacheImport.as = i.as;
+            cacheImport.isRelative = i.isRelative;
+            entry.imports.push_back(cacheImport);
+        }
+        for ( auto nsit = m_d->importTypes.begin(); nsit != m_d->importTypes.end(); ++nsit ){
+            for ( auto it = nsit->second.begin(); it != nsit->second.end(); ++it ){
+                CompileCache::Entry::ImportType cacheImportType;
+                cacheImportType.importNamespace = it->second.importNamespace.str();
+                cacheImportType.name = it->second.name.str();
+                entry.importTypes.push_back(cacheImportType);
+            }
+        }
+        entry.output = output;
+        cache->store(filePath(), entry);
+
+        m_d->hasCachedOutput = false;
+        m_d->cachedOutput.clear();
+    }
+}
+
+/**
+ * \brief Updates this file to \p content, which resulted from applying \p edits to the previous content
+ *
+ * The previous syntax tree is edited and reparsed incrementally. Top level components and
+ * instances that are outside the edits and outside the ranges reported as changed by the
+ * parser keep their converted js, whether they come before or after the edits, so the next
+ * compile() only converts the ones that were touched, unless the flat instance names before
+ * them shifted. The node tree is built again for the whole file, as its nodes refer to the
+ * replaced syntax tree. Exports, imports and types are collected and resolved again, new
+ * imports are compiled, and if the imports or the paths they resolve to changed, no output
+ * is reused. Changed exports are updated in the module, see propagateInterface().
+ */
+void ModuleFile::edit(const std::string &content, const std::vector<TSInputEdit> &edits){
+    Compiler::Ptr compiler = m_d->elementsModule->compiler();
+
+    m_d->hasCachedOutput = false;
+    m_d->cachedOutput.clear();
+    m_d->isInterfaceOnly = false;
+
+    LanguageParser::AST* ast = compiler->parser()->reparse(m_d->ast, content, edits);
+    std::vector<TSRange> changedRanges;
+    if ( m_d->ast ){
+        uint32_t rangeCount = 0;
+        TSRange* ranges = ts_tree_get_changed_ranges(
+            reinterpret_cast<TSTree*>(m_d->ast), reinterpret_cast<TSTree*>(ast), &rangeCount
+        );
+        changedRanges.assign(ranges, ranges + rangeCount);
+        free(ranges);
+        compiler->parser()->destroy(m_d->ast);
+    }
+    m_d->ast = ast;
+
+    std::string previousContent = m_d->content;
+    m_d->content = content;
+
+    ProgramNode* previousRoot = m_d->rootNode;
+    std::string previousImports = importSignature();
+    LanguageNodesToJs::ExportOutput previousOutput;
+    previousOutput.swap(m_d->exportOutput);
+
+    try{
+        m_d->rootNode = nullptr;
+        m_d->rootNode = compiler->parseProgramNodes(filePath(), m_d->name, ast);
+        compiler->collectProgramExports(m_d->content, m_d->rootNode);
+        collectInterface();
+        m_d->isReleased = false;
+        m_d->releasedContentHash.clear();
+    } catch ( ... ){
+        // the file still compiles from its last valid nodes, but these no longer match the
+        // syntax tree, so edits cannot be mapped onto them anymore
+        delete m_d->rootNode;
+        m_d->rootNode = previousRoot;
+        m_d->content = previousContent;
+        m_d->exportOutput.swap(previousOutput);
+        m_d->astMatchesNodes = false;
+        throw;
+    }
+
+    std::map<uint32_t, ConvertedExport*> previousOutputByStart;
+    if ( m_d->astMatchesNodes && previousRoot ){
+        for ( BaseNode* exportNode : previousRoot->exports() ){
+            auto it = previousOutput.find(exportNode);
+            if ( it != previousOutput.end() )
+                previousOutputByStart[exportNode->startByte()] = &it->second;
+        }
+    }
+    m_d->astMatchesNodes = true;
+
+    for ( BaseNode* exportNode : m_d->rootNode->exports() ){
+        uint32_t start = exportNode->startByte();
+        uint32_t end   = exportNode->endByte();
+        if ( intersectsRanges(changedRanges, start, end) || !mapRangeBeforeEdits(edits, start, end) )
+            continue;
+
+        auto it = previousOutputByStart.find(start);
+        if ( it != previousOutputByStart.end() ){
+            m_d->exportOutput[exportNode] = std::move(*it->second);
+        }
+    }
+
+    delete previousRoot;
+
+    try{
+        ElementsModule::resolveFileImports(module(), this);
+    } catch ( ... ){
+        m_d->exportOutput.clear();
+        throw;
+    }
+    propagateInterface();
+
+    // reused output refers to imported types by their resolved paths and aliases
+    if ( importSignature() != previousImports )
+        m_d->exportOutput.clear();
+}
+
+/**
+ * \brief Updates the module with the interface of this file, collected again, and resolves
+ * the types of this file again
+ *
+ * If the exports changed, the files resolving against them are resolved again as well, and
+ * the whole module is checked for cycles.
+ */
+void ModuleFile::propagateInterface(){
+    bool exportsChanged = m_d->elementsModule->updateFileExports(this);
+    clearDependencies();
+    resolveTypes();
+
+    if ( !exportsChanged ){
+        assertNoCycles({this});
+        return;
+    }
+
+    // the other files resolved before this one
+    std::vector<ModuleFile*> files = m_d->elementsModule->moduleFiles();
+    files.erase(std::remove(files.begin(), files.end(), this), files.end());
+    files.push_back(this);
+    assertNoCycles(files);
+}
+
+/**
+ * \brief Resolves the types of this file again, after the exports it resolves against changed
+ */
+void ModuleFile::reresolveTypes(){
+    std::string previousImports = importSignature();
+    clearDependencies();
+    resolveTypes();
+    if ( importSignature() != previousImports )
+        m_d->exportOutput.clear();
 }
 
 ModuleFile::State ModuleFile::state() const{
@@ -132,24 +375,119 @@ const std::string &ModuleFile::name() const{
     return m_d->name;
 }
 
-std::string ModuleFile::fileName() const{
-    return m_d->name + ".lv";
+const std::string& ModuleFile::fileName() const{
+    return m_d->fileName;
+}
+
+const std::string& ModuleFile::jsFileName() const{
+    return m_d->jsFileName;
+}
+
+const std::string& ModuleFile::jsFilePath() const{
+    return m_d->jsFilePath;
+}
+
+const std::string& ModuleFile::filePath() const{
+    return m_d->filePath;
+}
+
+/**
+ * \brief Source of this file, which is empty while the file is released
+ */
+const std::string &ModuleFile::content() const{
+    return m_d->content;
 }
 
-std::string ModuleFile::jsFileName() const{
-    return fileName() + m_d->elementsModule->compiler()->outputExtension();
+std::string ModuleFile::contentHash() const{
+    return m_d->isReleased ? m_d->releasedContentHash : CompileCache::hash(m_d->content);
 }
 
-std::string ModuleFile::jsFilePath() const{
-    return Path::join(m_d->elementsModule->compiler()->moduleBuildPath(m_d->elementsModule->module()), jsFileName());
+/**
+ * \brief Drops the syntax tree, nodes, converted output and source of this compiled file
+ *
+ * Exports, imports, resolved types and dependencies are kept, so the module can still
+ * resolve against this file. The file is read and parsed again by rematerialize() if it is
+ * compiled or edited later.
+ */
+void ModuleFile::release(){
+    if ( m_d->isReleased )
+        return;
+
+    m_d->releasedContentHash = CompileCache::hash(m_d->content);
+    m_d->isReleased = true;
+
+    delete m_d->rootNode;
+    m_d->rootNode = nullptr;
+    m_d->elementsModule->compiler()->parser()->destroy(m_d->ast);
+    m_d->ast = nullptr;
+    m_d->astMatchesNodes = true;
+
+    LanguageNodesToJs::ExportOutput().swap(m_d->exportOutput);
+    std::string().swap(m_d->content);
+    std::string().swap(m_d->cachedOutput);
+    std::string().swap(m_d->compiledOutput);
+    m_d->hasCachedOutput = false;
 }
 
-std::string ModuleFile::filePath() const{
-    return Path::join(m_d->elementsModule->module()->path(), fileName());
+/**
+ * \brief Reads and parses a released file again
+ *
+ * If the file changed on disk since it was released, its interface is collected again, new
+ * imports are compiled, and changed exports are updated in the module, see
+ * propagateInterface().
+ */
+void ModuleFile::rematerialize(){
+    if ( !m_d->isReleased )
+        return;
+    LV_COMPILER_TRACE_SPAN("rematerialize", filePath());
+
+    m_d->content = m_d->elementsModule->compiler()->fileIO()->readFromFile(filePath());
+    bool contentChanged = CompileCache::hash(m_d->content) != m_d->releasedContentHash;
+
+    m_d->elementsModule->compiler()->parser()->destroy(m_d->ast);
+    m_d->ast = nullptr;
+    parse();
+    m_d->isReleased = false;
+    m_d->releasedContentHash.clear();
+
+    if ( contentChanged ){
+        collectInterface();
+        ElementsModule::resolveFileImports(module(), this);
+        propagateInterface();
+    }
+}
+
+bool ModuleFile::isReleased() const{
+    return m_d->isReleased;
+}
+
+/**
+ * \brief Estimated bytes this file holds on to: its source, its converted output and its trees
+ *
+ * The syntax and node trees are not measured. While they are held, they are estimated at the
+ * size of the source once more, so released files weigh less in the module cache capacity.
+ */
+size_t ModuleFile::memorySize() const{
+    size_t size = m_d->content.size() + m_d->cachedOutput.size() + m_d->compiledOutput.size();
+    for ( auto it = m_d->exportOutput.begin(); it != m_d->exportOutput.end(); ++it )
+        size += it->second.js.size();
+    // estimate of the syntax and node trees
+    if ( m_d->rootNode )
+        size += m_d->content.size();
+    return size;
+}
+
+/**
+ * \brief Hands over the output kept for bundling, releasing it from this file
+ */
+std::string ModuleFile::takeCompiledOutput(){
+    std::string output = std::move(m_d->compiledOutput);
+    m_d->compiledOutput.clear();
+    return output;
 }
 
-const ElementsModule::Ptr &ModuleFile::module() const{
-    return m_d->elementsModule;
+ElementsModule::Ptr ModuleFile::module() const{
+    return m_d->elementsModuleRef.lock();
 }
 
 const std::list<ModuleFile::Export> &ModuleFile::exports() const{
@@ -160,45 +498,47 @@ const std::list<ModuleFile::Import> &ModuleFile::imports() const{
     return m_d->imports;
 }
 
+const std::list<ModuleFile *> &ModuleFile::dependencies() const{
+    return m_d->dependencies;
+}
+
 void ModuleFile::resolveImport(const std::string &uri, ElementsModule::Ptr epl){
     for ( auto it = m_d->imports.begin(); it != m_d->imports.end(); ++it ){
         if ( it->uri == uri )
             it->module = epl;
     }
+    if ( epl )
+        epl->addImporter(m_d->elementsModule);
 }
 
+/**
+ * \brief Adds an edge to \p dependency, cycles are checked once all edges are added, by assertNoCycles()
+ */
 void ModuleFile::addDependency(ModuleFile *dependency){
-    if ( dependency == this )
+    if ( dependency == this || hasDependency(this, dependency) )
         return;
     m_d->dependencies.push_back(dependency);
     dependency->m_d->dependents.push_back(this);
+}
 
-    PackageGraph::CyclesResult<ModuleFile*> cr = checkCycles(this);
-    if ( cr.found() ){
-        std::stringstream ss;
+void ModuleFile::clearDependencies(){
+    for ( ModuleFile* dependency : m_d->dependencies ){
+        dependency->m_d->dependents.remove(this);
+    }
+    m_d->dependencies.clear();
+    m_d->importedFiles.clear();
+}
 
-        for ( auto it = cr.path().begin(); it != cr.path().end(); ++it ){
-            ModuleFile* n = *it;
-            if ( it != cr.path().begin() )
-                ss << " -> ";
-            ss << n->name();
-        }
+const std::list<ModuleFile *> &ModuleFile::importedFiles() const{
+    return m_d->importedFiles;
+}
 
-        for ( auto it = m_d->dependencies.begin(); it != m_d->dependencies.end(); ++it ){
-            if ( *it == dependency ){
-                m_d->dependencies.erase(it);
-                break;
-            }
-        }
-        for ( auto it = dependency->m_d->dependents.begin(); it != dependency->m_d->dependents.end(); ++it ){
-            if ( *it == this ){
-                dependency->m_d->dependents.erase(it);
-                break;
-            }
-        }
+bool ModuleFile::isReachable() const{
+    return m_d->isReachable;
+}
 
-        THROW_EXCEPTION(lv::Exception, "Module file dependency cycle found: "  + ss.str(), lv::Exception::toCode("Cycle"));
-    }
+void ModuleFile::setReachable(bool reachable){
+    m_d->isReachable = reachable;
 }
 
 void ModuleFile::setCompilationData(CompilationData *cd){
@@ -215,34 +555,43 @@ bool ModuleFile::hasDependency(ModuleFile *module, ModuleFile *dependency){
     return false;
 }
 
-PackageGraph::CyclesResult<ModuleFile *> ModuleFile::checkCycles(ModuleFile *mf){
-    std::list<ModuleFile*> path;
-    path.push_back(mf);
-
-    for ( auto it = mf->m_d->dependencies.begin(); it != mf->m_d->dependencies.end(); ++it ){
-        PackageGraph::CyclesResult<ModuleFile*> cr = checkCycles(mf, *it, path);
-        if ( cr.found() )
-            return cr;
-    }
-    return PackageGraph::CyclesResult<ModuleFile*>(PackageGraph::CyclesResult<ModuleFile*>::NotFound);;
+/**
+ * \brief Finds a dependency cycle among the files reachable from \p files
+ *
+ * The files are expected in the order they resolved their types. The returned path starts
+ * at the file whose edge closed the cycle, as if the cycle had been checked for each edge.
+ */
+PackageGraph::CyclesResult<ModuleFile *> ModuleFile::checkCycles(const std::vector<ModuleFile*>& files){
+    std::list<ModuleFile*> path = DependencyCycles<ModuleFile>::find(files, [](ModuleFile* mf) -> const std::list<ModuleFile*>&{
+        return mf->m_d->dependencies;
+    });
+    if ( path.empty() )
+        return PackageGraph::CyclesResult<ModuleFile*>(PackageGraph::CyclesResult<ModuleFile*>::NotFound);
+    return PackageGraph::CyclesResult<ModuleFile*>(PackageGraph::CyclesResult<ModuleFile*>::Found, path);
 }
 
-PackageGraph::CyclesResult<ModuleFile*> ModuleFile::checkCycles(
-        ModuleFile *mf, ModuleFile *current, std::list<ModuleFile *> path)
-{
-    path.push_back(current);
-    if ( current == mf )
-        return PackageGraph::CyclesResult<ModuleFile*>(PackageGraph::CyclesResult<ModuleFile*>::Found, path);
-
-    for ( auto it = current->m_d->dependencies.begin(); it != current->m_d->dependencies.end(); ++it ){
-        PackageGraph::CyclesResult<ModuleFile*> cr = checkCycles(mf, *it, path);
-        if ( cr.found() )
-            return cr;
-    }
-    return PackageGraph::CyclesResult<ModuleFile*>(PackageGraph::CyclesResult<ModuleFile*>::NotFound);
+/**
+ * \brief Throws if the files reachable from \p files depend on each other in a cycle
+ *
+ * Cycles are checked once all the edges are added, instead of for each edge. The edge that
+ * closed the reported cycle is removed before throwing.
+ */
+void ModuleFile::assertNoCycles(const std::vector<ModuleFile*>& files){
+    PackageGraph::CyclesResult<ModuleFile*> cr = checkCycles(files);
+    if ( !cr.found() )
+        return;
+
+    std::string path = DependencyCycles<ModuleFile>::toString(cr.path(), [](ModuleFile* mf){ return mf->name(); });
+
+    ModuleFile* from = cr.path().front();
+    ModuleFile* dependency = *std::next(cr.path().begin());
+    from->m_d->dependencies.remove(dependency);
+    dependency->m_d->dependents.remove(from);
+
+    THROW_EXCEPTION(lv::Exception, "Module file dependency cycle found: "  + path, lv::Exception::toCode("Cycle"));
 }
 
-ModuleFile::ModuleFile(ElementsModule::Ptr plugin, const std::string &name, const std::string &content, ProgramNode *node)
+ModuleFile::ModuleFile(ElementsModule::Ptr plugin, const std::string &name, const std::string &content)
     : m_d(new ModuleFilePrivate)
 {
     std::string componentName = name;
@@ -250,15 +599,129 @@ ModuleFile::ModuleFile(ElementsModule::Ptr plugin, const std::string &name, cons
     if ( extension != std::string::npos )
         componentName = componentName.substr(0, extension);
 
-    m_d->elementsModule = plugin;
+    m_d->elementsModule = plugin.get();
+    m_d->elementsModuleRef = plugin;
     m_d->name = componentName;
+    m_d->fileName = componentName + ".lv";
+    m_d->jsFileName = m_d->fileName + plugin->compiler()->outputExtension();
+    m_d->filePath = Path::join(plugin->module()->path(), m_d->fileName);
+    m_d->jsFilePath = Path::join(plugin->compiler()->moduleBuildPath(plugin->module()), m_d->jsFileName);
     m_d->state = ModuleFile::Initiaized;
     m_d->content = content;
-    m_d->rootNode = node;
+    m_d->rootNode = nullptr;
+    m_d->ast = nullptr;
+    m_d->astMatchesNodes = true;
+    m_d->hasCachedOutput = false;
+    m_d->isInterfaceOnly = false;
     m_d->compilationData = nullptr;
+    m_d->isReachable = false;
+    m_d->isReleased = false;
+}
 
-    std::vector<BaseNode*> exports = m_d->elementsModule->compiler()->collectProgramExports(content, node);
+/**
+ * \brief Sets the exports and imports of a file whose output was written by a previous build
+ *
+ * The file is not parsed, and compile() does nothing until the file is edited.
+ */
+void ModuleFile::setInterface(const std::list<ModuleFile::Export> &exports, const std::list<ModuleFile::Import> &imports){
+    m_d->exports = exports;
+    m_d->imports = imports;
+    m_d->isInterfaceOnly = true;
+}
 
+/**
+ * \brief Loads the exports, imports and used types of this file
+ *
+ * These are read from the compile cache if it has a valid entry for the file, in which case
+ * parsing is deferred until the file needs to be converted.
+ */
+void ModuleFile::load(){
+    LV_COMPILER_TRACE_SPAN("loadModuleFile", filePath());
+    Compiler::Ptr compiler = m_d->elementsModule->compiler();
+    CompileCache* cache = compiler->compileCache();
+    if ( cache ){
+        CompileCache::Entry entry;
+        if ( cache->find(filePath(), compiler->configHash(), CompileCache::hash(m_d->content), entry) ){
+            for ( const CompileCache::Entry::Export& cacheExport : entry.exports ){
+                ModuleFile::Export expt;
+                expt.type = cacheExport.isComponent ? ModuleFile::Export::Component : ModuleFile::Export::Element;
+                expt.name = cacheExport.name;
+                m_d->exports.push_back(expt);
+            }
+            for ( const CompileCache::Entry::Import& cacheImport : entry.imports ){
+                ModuleFile::Import imp;
+                imp.uri = cacheImport.uri;
+                imp.as = cacheImport.as;
+                imp.isRelative = cacheImport.isRelative;
+                m_d->imports.push_back(imp);
+            }
+            m_d->strings = StringInterner::create();
+            for ( const CompileCache::Entry::ImportType& cacheImportType : entry.importTypes ){
+                ProgramNode::ImportType impType;
+                impType.importNamespace = m_d->strings->intern(cacheImportType.importNamespace);
+                impType.name = m_d->strings->intern(cacheImportType.name);
+                m_d->importTypes[impType.importNamespace][impType.name] = impType;
+            }
+            m_d->cachedOutput.swap(entry.output);
+            m_d->cachedResolutionHash = entry.resolutionHash;
+            m_d->hasCachedOutput = true;
+            return;
+        }
+    }
+
+    parse();
+    collectInterface();
+}
+
+void ModuleFile::parse(){
+    LV_COMPILER_TRACE_SPAN("parse", filePath());
+    Compiler::Ptr compiler = m_d->elementsModule->compiler();
+
+    LanguageParser::AST* ast = compiler->parser()->parse(m_d->content);
+    ProgramNode* rootNode = nullptr;
+    try{
+        rootNode = compiler->parseProgramNodes(filePath(), m_d->name, ast);
+        compiler->collectProgramExports(m_d->content, rootNode);
+    } catch ( ... ){
+        delete rootNode;
+        compiler->parser()->destroy(ast);
+        throw;
+    }
+
+    m_d->ast = ast;
+    m_d->rootNode = rootNode;
+    m_d->astMatchesNodes = true;
+}
+
+/**
+ * \brief Hash of the paths the used types resolved to, which the output depends on besides the content
+ */
+std::string ModuleFile::resolutionHash() const{
+    const Module::Ptr& module = m_d->elementsModule->module();
+    std::string resolution = module->context() ? module->context()->importId.data() : "";
+    for ( auto nsit = m_d->importTypes.begin(); nsit != m_d->importTypes.end(); ++nsit ){
+        for ( auto it = nsit->second.begin(); it != nsit->second.end(); ++it ){
+            resolution += "|" + it->second.importNamespace.str() + "." + it->second.name.str() + "=" + it->second.resolvedPath;
+        }
+    }
+    return CompileCache::hash(resolution);
+}
+
+/**
+ * \brief Imports of this file together with the types they resolve to
+ */
+std::string ModuleFile::importSignature() const{
+    std::string signature;
+    for ( const ModuleFile::Import& imp : m_d->imports )
+        signature += imp.uri + " as " + imp.as + "|";
+    return signature + resolutionHash();
+}
+
+void ModuleFile::collectInterface(){
+    const std::string& content = m_d->content;
+    std::vector<BaseNode*> exports = m_d->rootNode->exports();
+
+    m_d->exports.clear();
     for ( auto val : exports ){
         if ( val->isNodeType<ComponentInstanceStatementNode>() ){
             auto expression = val->as<ComponentInstanceStatementNode>();
@@ -276,15 +739,27 @@ ModuleFile::ModuleFile(ElementsModule::Ptr plugin, const std::string &name, cons
         }
     }
 
-    std::vector<ImportNode*> imports = node->imports();
+    std::list<ModuleFile::Import> previousImports;
+    previousImports.swap(m_d->imports);
+
+    std::vector<ImportNode*> imports = m_d->rootNode->imports();
 
     for ( auto val : imports ){
         ModuleFile::Import imp;
         imp.uri = val->path(content);
         imp.as = val->as(content);
         imp.isRelative = val->isRelative();
+        for ( const ModuleFile::Import& previous : previousImports ){
+            if ( previous.uri == imp.uri ){
+                imp.module = previous.module;
+                break;
+            }
+        }
         m_d->imports.push_back(imp);
     }
+
+    m_d->importTypes = m_d->rootNode->importTypes();
+    m_d->strings = m_d->rootNode->strings();
 }
 
 }} // namespace lv, el
@@ -18,10 +18,12 @@
 
 #include "live/elements/compiler/lvelcompilerglobal.h"
 #include "live/elements/compiler/elementsmodule.h"
+#include "live/elements/compiler/languageparser.h"
 #include "live/packagegraph.h"
 
 #include <memory>
 #include <list>
+#include <vector>
 
 namespace lv{ namespace el{
 
@@ -76,28 +78,49 @@ public:
 
     void resolveTypes();
     void compile();
+    void edit(const std::string& content, const std::vector<TSInputEdit>& edits);
 
     State state() const;
     const std::string& name() const;
-    std::string fileName() const;
-    std::string jsFileName() const;
-    std::string jsFilePath() const;
-    std::string filePath() const;
-    const ElementsModule::Ptr& module() const;
+    const std::string& fileName() const;
+    const std::string& jsFileName() const;
+    const std::string& jsFilePath() const;
+    const std::string& filePath() const;
+    ElementsModule::Ptr module() const;
     const std::list<Export>& exports() const;
     const std::list<Import>& imports() const;
+    const std::list<ModuleFile*>& dependencies() const;
     void resolveImport(const std::string& uri, ElementsModule::Ptr epl);
 
 private:
     void addDependency(ModuleFile* to);
+    void clearDependencies();
+    const std::list<ModuleFile*>& importedFiles() const;
+    bool isReachable() const;
+    void setReachable(bool reachable);
     void setCompilationData(CompilationData* cd);
+    void load();
+    void setInterface(const std::list<Export>& exports, const std::list<Import>& imports);
+    const std::string& content() const;
+    std::string contentHash() const;
+    void release();
+    void rematerialize();
+    bool isReleased() const;
+    size_t memorySize() const;
+    std::string takeCompiledOutput();
+    void parse();
+    void collectInterface();
+    void propagateInterface();
+    void reresolveTypes();
+    std::string resolutionHash() const;
+    std::string importSignature() const;
 
     bool hasDependency(ModuleFile* module, ModuleFile* dependency);
-    static PackageGraph::CyclesResult<ModuleFile*> checkCycles(ModuleFile* mf);
-    static PackageGraph::CyclesResult<ModuleFile*> checkCycles(ModuleFile* mf, ModuleFile* current, std::list<ModuleFile*> path);
+    static PackageGraph::CyclesResult<ModuleFile*> checkCycles(const std::vector<ModuleFile*>& files);
+    static void assertNoCycles(const std::vector<ModuleFile*>& files);
 
 
-    ModuleFile(ElementsModule::Ptr plugin, const std::string& name, const std::string& content, ProgramNode* node);
+    ModuleFile(ElementsModule::Ptr plugin, const std::string& name, const std::string& content);
 
     ModuleFilePrivate* m_d;
 
@@ -0,0 +1,216 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+
+#include "outputqueue_p.h"
+#include "compilecache_p.h"
+#include "live/fileio.h"
+#include "live/path.h"
+
+namespace lv{ namespace el{
+
+OutputQueue::OutputQueue(FileIOInterface *fileIO, bool async)
+    : m_fileIO(fileIO)
+    , m_async(async)
+    , m_totalWritten(0)
+    , m_totalSkipped(0)
+    , m_processing(0)
+    , m_stopped(false)
+{
+    if ( m_async )
+        m_thread = std::thread([this](){ workerLoop(); });
+}
+
+OutputQueue::~OutputQueue(){
+    if ( m_async ){
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            m_stopped = true;
+        }
+        m_queueChanged.notify_all();
+        m_thread.join();
+    }
+}
+
+/**
+ * \brief Writes \p content to \p path, unless the file already holds the same content
+ */
+void OutputQueue::write(const std::string &path, const std::string &content){
+    Job job;
+    job.path = path;
+    job.content = content;
+    push(std::move(job));
+}
+
+/**
+ * \brief Copies \p from to \p to, unless \p to already holds the same content
+ */
+void OutputQueue::copyFile(const std::string &from, const std::string &to){
+    Job job;
+    job.path = to;
+    job.copyFrom = from;
+    job.isCopy = true;
+    push(std::move(job));
+}
+
+/**
+ * \brief Waits for the queued jobs, throwing if any of them failed since the last flush
+ */
+void OutputQueue::flush(){
+    if ( m_async ){
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_queueChanged.wait(lock, [this](){ return m_jobs.empty() && m_processing == 0; });
+    }
+
+    std::vector<std::string> failures;
+    {
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        failures.swap(m_failures);
+        m_directories.clear();
+    }
+    if ( !failures.empty() ){
+        std::string paths;
+        for ( const std::string& failure : failures ){
+            if ( !paths.empty() )
+                paths += ", ";
+            paths += failure;
+        }
+        THROW_EXCEPTION(lv::Exception, "Failed to write output files: " + paths, lv::Exception::toCode("~File"));
+    }
+}
+
+void OutputQueue::push(Job &&job){
+    if ( !m_async ){
+        process(job);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_queueChanged.notify_all();
+}
+
+void OutputQueue::workerLoop(){
+    std::deque<Job> batch;
+    while ( true ){
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_processing = 0;
+            m_queueChanged.notify_all();
+            m_queueChanged.wait(lock, [this](){ return m_stopped || !m_jobs.empty(); });
+            if ( m_jobs.empty() )
+                return;
+            batch.swap(m_jobs);
+            m_processing = batch.size();
+        }
+
+        // a path written twice in the same batch only needs its last content
+        std::map<std::string, size_t> lastJob;
+        for ( size_t i = 0; i < batch.size(); ++i )
+            lastJob[batch[i].path] = i;
+        for ( size_t i = 0; i < batch.size(); ++i ){
+            if ( lastJob[batch[i].path] != i ){
+                std::lock_guard<std::mutex> guard(m_stateMutex);
+                ++m_totalSkipped;
+                continue;
+            }
+            try{
+                process(batch[i]);
+            } catch ( ... ){
+                std::lock_guard<std::mutex> guard(m_stateMutex);
+                m_writtenFiles.erase(batch[i].path);
+                m_failures.push_back(batch[i].path);
+            }
+        }
+        batch.clear();
+    }
+}
+
+void OutputQueue::process(const Job &job){
+    std::string contentHash;
+    if ( job.isCopy ){
+        contentHash = CompileCache::hash(m_fileIO->readFromFile(job.copyFrom));
+    } else {
+        contentHash = CompileCache::hash(job.content);
+    }
+
+    bool knownPath = false;
+    WrittenFile known;
+    {
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        auto it = m_writtenFiles.find(job.path);
+        if ( it != m_writtenFiles.end() ){
+            knownPath = true;
+            known = it->second;
+        }
+    }
+
+    // the recorded hash only holds while nothing else touched the file
+    bool exists = Path::exists(job.path);
+    if ( knownPath && exists && !(known.modified < Path::lastModified(job.path)) ){
+        if ( known.contentHash == contentHash ){
+            std::lock_guard<std::mutex> guard(m_stateMutex);
+            ++m_totalSkipped;
+            return;
+        }
+    } else if ( exists && CompileCache::hash(m_fileIO->readFromFile(job.path)) == contentHash ){
+        WrittenFile current;
+        current.contentHash = contentHash;
+        current.modified = Path::lastModified(job.path);
+
+        std::lock_guard<std::mutex> guard(m_stateMutex);
+        m_writtenFiles[job.path] = current;
+        ++m_totalSkipped;
+        return;
+    }
+
+    createDirectory(Path::parent(job.path));
+
+    bool written = true;
+    if ( job.isCopy ){
+        Path::copyFile(job.copyFrom, job.path, Path::OverwriteExisting);
+    } else {
+        written = m_fileIO->writeToFile(job.path, job.content);
+    }
+
+    WrittenFile current;
+    if ( written ){
+        current.contentHash = contentHash;
+        current.modified = Path::lastModified(job.path);
+    }
+
+    std::lock_guard<std::mutex> guard(m_stateMutex);
+    if ( written ){
+        m_writtenFiles[job.path] = current;
+        ++m_totalWritten;
+    } else {
+        m_writtenFiles.erase(job.path);
+        m_failures.push_back(job.path);
+    }
+}
+
+void OutputQueue::createDirectory(const std::string &path){
+    if ( path.empty() )
+        return;
+    std::lock_guard<std::mutex> guard(m_stateMutex);
+    if ( !m_directories.insert(path).second )
+        return;
+    if ( !Path::exists(path) )
+        Path::createDirectories(path);
+}
+
+}} // namespace lv, el
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVOUTPUTQUEUE_H
+#define LVOUTPUTQUEUE_H
+
+#include "live/elements/compiler/lvelcompilerglobal.h"
+#include "live/exception.h"
+#include "live/datetime.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace lv{
+
+class FileIOInterface;
+
+namespace el{
+
+/**
+ * \class OutputQueue
+ * \brief Writes build output and copies assets, skipping files whose content is unchanged.
+ *
+ * A file is only written if the hash of its content differs from what is already at its path,
+ * so unchanged outputs keep their modification time. Hashes of written files are only trusted
+ * while the file is still on disk and has not been modified since, and created directories are
+ * remembered until the next flush(). In asynchronous mode, jobs are processed in batches on a background thread, and flush()
+ * waits for them. Failed writes are reported by the next flush().
+ */
+class OutputQueue{
+
+    DISABLE_COPY(OutputQueue);
+
+private:
+    class Job{
+    public:
+        Job() : isCopy(false){}
+
+        std::string path;
+        std::string content;
+        std::string copyFrom;
+        bool        isCopy;
+    };
+
+    class WrittenFile{
+    public:
+        std::string contentHash;
+        DateTime    modified;
+    };
+
+public:
+    OutputQueue(FileIOInterface* fileIO, bool async);
+    ~OutputQueue();
+
+    void write(const std::string& path, const std::string& content);
+    void copyFile(const std::string& from, const std::string& to);
+    void flush();
+
+    size_t totalWritten() const;
+    size_t totalSkipped() const;
+
+private:
+    void push(Job&& job);
+    void workerLoop();
+    void process(const Job& job);
+    void createDirectory(const std::string& path);
+
+    FileIOInterface*           m_fileIO;
+    bool                       m_async;
+
+    std::mutex                 m_stateMutex;
+    std::set<std::string>      m_directories;
+    std::map<std::string, WrittenFile> m_writtenFiles;
+    std::vector<std::string>   m_failures;
+    size_t                     m_totalWritten;
+    size_t                     m_totalSkipped;
+
+    std::mutex                 m_queueMutex;
+    std::condition_variable    m_queueChanged;
+    std::deque<Job>            m_jobs;
+    size_t                     m_processing;
+    bool                       m_stopped;
+    std::thread                m_thread;
+};
+
+inline size_t OutputQueue::totalWritten() const{
+    return m_totalWritten;
+}
+
+inline size_t OutputQueue::totalSkipped() const{
+    return m_totalSkipped;
+}
+
+}} // namespace lv, el
+
+#endif // LVOUTPUTQUEUE_H
@@ -14,6 +14,7 @@
 ****************************************************************************/
 
 #include "parseddocument.h"
+#include "languagesymbols_p.h"
 #include "live/visuallog.h"
 
 #include "tree_sitter/parser.h"
@@ -31,6 +32,7 @@ std::string ParsedDocument::slice(const std::string &source, TSNode node)
 }
 
 std::vector<ImportInfo> ParsedDocument::extractImports(const std::string &source, LanguageParser::AST *ast){
+    const LanguageSymbols& symbols = LanguageSymbols::elements();
     TSTree* tree = reinterpret_cast<TSTree*>(ast);
     TSNode root_node = ts_tree_root_node(tree);
 
@@ -40,7 +42,7 @@ std::vector<ImportInfo> ParsedDocument::extractImports(const std::string &source
     for (uint32_t i = 0; i < count; ++i)
     {
         TSNode child = ts_node_child(root_node, i);
-        if (strcmp(ts_node_type(child), "import_statement") == 0)
+        if (symbols.symbol(child) == LanguageSymbols::ImportStatement)
         {
             bool rel = false;
             std::vector<Utf8> segs;
@@ -51,16 +53,16 @@ std::vector<ImportInfo> ParsedDocument::extractImports(const std::string &source
             while (j < import_count)
             {
                 TSNode import_child = ts_node_child(child, j);
-                if (strcmp(ts_node_type(import_child), ".") == 0)
+                if (symbols.symbol(import_child) == LanguageSymbols::Dot)
                 {
                     rel = true;
-                } else if (strcmp(ts_node_type(import_child), "import_path") == 0) {
+                } else if (symbols.symbol(import_child) == LanguageSymbols::ImportPath) {
                     auto import_child_count = ts_node_child_count(import_child);
                     for (uint32_t k = 0; k < import_child_count; k+=2)
                     {
                         segs.push_back(slice(source, ts_node_child(import_child, k)));
                     }
-                } else if (strcmp(ts_node_type(import_child), "import_as") == 0) {
+                } else if (symbols.symbol(import_child) == LanguageSymbols::ImportAs) {
                     alias = slice(source, ts_node_child(import_child, 1));
                 }
                 ++j;
@@ -320,6 +322,7 @@ void ParsedDocument::treePath(LanguageParser::AST *ast, uint32_t position, std::
 
 TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node)
 {
+    const LanguageSymbols& symbols = LanguageSymbols::elements();
     Utf8                      typeName;
     // Utf8                      className; = ?
     Utf8                      inherits = "Element";
@@ -330,9 +333,9 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
     // bool                      isCreatable; = false
     bool                      isInstance = false;
 
-    if (strcmp(ts_node_type(node), "new_component_expression") == 0)
+    if (symbols.symbol(node) == LanguageSymbols::NewComponentExpression)
     {
-        if (strcmp(ts_node_type(ts_node_child(node, 0)), "component_instance") != 0)
+        if (symbols.symbol(ts_node_child(node, 0)) != LanguageSymbols::ComponentInstance)
             return nullptr;
         isInstance = true;
     }
@@ -344,11 +347,11 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
     {
         TSNode cdChild = ts_node_child(node, i);
 
-        if (strcmp(ts_node_type(cdChild), "identifier") == 0)
+        if (symbols.symbol(cdChild) == LanguageSymbols::Identifier)
         {
             typeName = slice(source, cdChild);
         }
-        else if (strcmp(ts_node_type(cdChild), "component_heritage") == 0)
+        else if (symbols.symbol(cdChild) == LanguageSymbols::ComponentHeritage)
         {
 
             auto start = ts_node_start_byte(ts_node_child(cdChild, 1));
@@ -356,20 +359,20 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
             inherits = source.substr(start, length);
 
         }
-        else if (strcmp(ts_node_type(cdChild), "component_body") == 0)
+        else if (symbols.symbol(cdChild) == LanguageSymbols::ComponentBody)
         {
             auto component_body_count = ts_node_child_count(cdChild);
             for (uint32_t cb = 1; cb < component_body_count-1; ++cb)
             {
                 TSNode component_body_child = ts_node_child(cdChild, cb);
 
-                if (strcmp(ts_node_type(component_body_child), "property_declaration") == 0)
+                if (symbols.symbol(component_body_child) == LanguageSymbols::PropertyDeclaration)
                 {
                     Utf8 type = slice(source, ts_node_child(component_body_child, 0));
                     Utf8 name = slice(source, ts_node_child(component_body_child, 1));
                     properties.push_back(PropertyInfo(name, type));
                 }
-                else if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0 || strcmp(ts_node_type(component_body_child), "event_declaration") == 0)
+                else if (symbols.symbol(component_body_child) == LanguageSymbols::TypedFunctionDeclaration || symbols.symbol(component_body_child) == LanguageSymbols::EventDeclaration)
                 {
                     Utf8 funcName = slice(source, ts_node_child(component_body_child, 1));
                     FunctionInfo fi(funcName);
@@ -381,7 +384,7 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
                         TSNode formal_type_parameter = ts_node_child(formal_type_parameters, ftpcidx);
                         fi.addParameter(slice(source, ts_node_child(formal_type_parameter, 1)), slice(source, ts_node_child(formal_type_parameter, 0)));
                     }
-                    if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0)
+                    if (symbols.symbol(component_body_child) == LanguageSymbols::TypedFunctionDeclaration)
                         functions.push_back(fi);
                     else
                         events.push_back(fi);
@@ -408,6 +411,7 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
 }
 
 DocumentInfo::Ptr ParsedDocument::extractInfo(const std::string &source, LanguageParser::AST *ast){
+    const LanguageSymbols& symbols = LanguageSymbols::elements();
     TSTree* tree = reinterpret_cast<TSTree*>(ast);
     TSNode root_node = ts_tree_root_node(tree);
 
@@ -416,7 +420,7 @@ DocumentInfo::Ptr ParsedDocument::extractInfo(const std::string &source, Languag
     for (uint32_t i = 0; i < count; ++i)
     {
         TSNode child = ts_node_child(root_node, i);
-        if (strcmp(ts_node_type(child), "import_statement") == 0)
+        if (symbols.symbol(child) == LanguageSymbols::ImportStatement)
         {
             bool rel = false;
             std::vector<Utf8> segs;
@@ -427,16 +431,16 @@ DocumentInfo::Ptr ParsedDocument::extractInfo(const std::string &source, Languag
             while (j < import_count)
             {
                 TSNode import_child = ts_node_child(child, j);
-                if (strcmp(ts_node_type(import_child), ".") == 0)
+                if (symbols.symbol(import_child) == LanguageSymbols::Dot)
                 {
                     rel = true;
-                } else if (strcmp(ts_node_type(import_child), "import_path") == 0) {
+                } else if (symbols.symbol(import_child) == LanguageSymbols::ImportPath) {
                     auto import_child_count = ts_node_child_count(import_child);
                     for (uint32_t k = 0; k < import_child_count; k+=2)
                     {
                         segs.push_back(slice(source, ts_node_child(import_child, k)));
                     }
-                } else if (strcmp(ts_node_type(import_child), "import_as") == 0) {
+                } else if (symbols.symbol(import_child) == LanguageSymbols::ImportAs) {
                     alias = slice(source, ts_node_child(import_child, 1));
                 }
                 ++j;
@@ -444,15 +448,15 @@ DocumentInfo::Ptr ParsedDocument::extractInfo(const std::string &source, Languag
 
             result->addImport(ImportInfo(segs, alias, rel));
         }
-        else if (strcmp(ts_node_type(child), "component_declaration") == 0)
+        else if (symbols.symbol(child) == LanguageSymbols::ComponentDeclaration)
         {
             TypeInfo::Ptr res = extractType(source, child);
             result->addType(res);
         }
-        else if (strcmp(ts_node_type(child), "expression_statement") == 0)
+        else if (symbols.symbol(child) == LanguageSymbols::ExpressionStatement)
         {
 
-            if (ts_node_child_count(child) == 1 && strcmp(ts_node_type(ts_node_child(child, 0)), "new_component_expression") == 0)
+            if (ts_node_child_count(child) == 1 && symbols.symbol(ts_node_child(child, 0)) == LanguageSymbols::NewComponentExpression)
             {
                 TypeInfo::Ptr res = extractType(source, ts_node_child(child, 0));
                 if (res != nullptr) result->addType(res);
@@ -5,28 +5,12 @@
 
 namespace lv{ namespace el{
 
-// PropertyBindingContainer::Node
-// ------------------------------------------------------------------
-
-PropertyBindingContainer::Node::~Node(){
-    for ( auto it = next.begin(); it != next.end(); ++it ){
-        delete *it;
-    }
-}
-
-PropertyBindingContainer::Node *PropertyBindingContainer::Node::findNextIdentifier(const std::string &name) const{
-    for ( auto it = next.begin(); it != next.end(); ++it ){
-        if ( (*it)->name == name ){
-            return *it;
-        }
-    }
-    return nullptr;
-}
-
 // PropertyBindingContainer
 // ------------------------------------------------------------------
 
-PropertyBindingContainer::PropertyBindingContainer(){
+PropertyBindingContainer::PropertyBindingContainer()
+    : m_isCompiled(false)
+{
 }
 
 PropertyBindingContainer::~PropertyBindingContainer(){
@@ -34,46 +18,106 @@ PropertyBindingContainer::~PropertyBindingContainer(){
 
 void PropertyBindingContainer::addBinding(BaseNode *binding){
     m_bindings.push_back(binding);
+    m_isCompiled = false;
 }
 
-void PropertyBindingContainer::setDeclarationCheck(std::function<bool (const std::string&, const std::string &, BaseNode *)> fn){
+void PropertyBindingContainer::setDeclarationCheck(std::function<bool (const std::string&, std::string_view, BaseNode *)> fn){
     m_declarationCheck = fn;
+    m_isCompiled = false;
 }
 
-std::string PropertyBindingContainer::bindingIdentifiersToString(const std::string &source) const{
-    auto result = bindingIdentifiers(source);
+/**
+ * \brief Drops the compiled dependencies, so they are compiled again on the next use
+ */
+void PropertyBindingContainer::invalidate(){
+    m_isCompiled = false;
+}
 
-    if ( result.empty() )
-        return "";
+std::string PropertyBindingContainer::bindingIdentifiersToString(const std::string &source, StringInterner &strings) const{
+    compile(source, strings);
 
-    std::string stringResult;
-    for ( auto it = result.begin(); it != result.end(); ++it ){
-        if ( it != result.begin() )
-            stringResult += "\n";
-        stringResult += bindingIdentifierToString(*it);
-        delete *it;
+    std::string result;
+    for ( auto it = m_roots.begin(); it != m_roots.end(); ++it ){
+        if ( it != m_roots.begin() )
+            result += "\n";
+        bindingIdentifierToString(*it, result);
     }
-    result.clear();
-
-    return stringResult;
+    return result;
 }
 
-std::string PropertyBindingContainer::bindingIdentifiersToJs(const std::string &source) const{
-    auto result = bindingIdentifiers(source);
+/**
+ * \brief Returns the dependencies as a js array, or an empty string if there are none
+ *
+ * The result is interned in \p strings, so equal dependency sets share the same string.
+ */
+const std::string& PropertyBindingContainer::bindingIdentifiersToJs(const std::string &source, StringInterner &strings) const{
+    compile(source, strings);
+    return m_js.str();
+}
 
-    if ( result.empty() )
-        return "";
+/**
+ * \brief Checks whether every dependency is a constant of a frozen js global, like \c Math.PI
+ *
+ * Such dependencies never change, so the binding would only ever be evaluated once and can be
+ * emitted as a plain assignment. A global whose name is taken by an id, a component or a
+ * declaration around the binding is not the global.
+ */
+bool PropertyBindingContainer::hasOnlyConstantDependencies(const std::string &source, StringInterner &strings) const{
+    compile(source, strings);
+    if ( m_roots.empty() )
+        return false;
+
+    for ( size_t root : m_roots ){
+        std::string_view name = m_nodes[root].name.view();
+        if ( !isFrozenGlobal(name) )
+            return false;
+        for ( size_t member : m_nodes[root].next ){
+            if ( !isConstantGlobalMember(name, m_nodes[member].name.view()) )
+                return false;
+        }
+    }
 
-    std::string stringResult = "[";
-    for ( auto it = result.begin(); it != result.end(); ++it ){
-        if ( it != result.begin() )
-            stringResult += ",";
-        stringResult += bindingIdentifierToJs(*it);
-        delete *it;
+    for ( BaseNode* binding : m_bindings ){
+        if ( !binding->isNodeType<MemberExpressionNode>() )
+            continue;
+        auto identifierChain = binding->as<MemberExpressionNode>()->identifierChain(source);
+        if ( identifierChain.size() > 1 && BaseNode::isDeclaredInScope(source, binding, identifierChain.front()) )
+            return false;
     }
-    result.clear();
+    return true;
+}
+
+/**
+ * \brief Checks whether \p name is a js global whose value members can't be written or removed
+ */
+bool PropertyBindingContainer::isFrozenGlobal(std::string_view name){
+    return name == "Math" || name == "Number";
+}
 
-    return stringResult + "]";
+/**
+ * \brief Checks whether \p member of the frozen global \p name is one of its constants
+ */
+bool PropertyBindingContainer::isConstantGlobalMember(std::string_view name, std::string_view member){
+    static const std::string_view mathConstants[] = {
+        "E", "LN10", "LN2", "LOG10E", "LOG2E", "PI", "SQRT1_2", "SQRT2"
+    };
+    static const std::string_view numberConstants[] = {
+        "EPSILON", "MAX_SAFE_INTEGER", "MAX_VALUE", "MIN_SAFE_INTEGER", "MIN_VALUE",
+        "NaN", "NEGATIVE_INFINITY", "POSITIVE_INFINITY"
+    };
+
+    if ( name == "Math" ){
+        for ( std::string_view constant : mathConstants ){
+            if ( constant == member )
+                return true;
+        }
+    } else if ( name == "Number" ){
+        for ( std::string_view constant : numberConstants ){
+            if ( constant == member )
+                return true;
+        }
+    }
+    return false;
 }
 
 /*
@@ -92,8 +136,13 @@ std::string PropertyBindingContainer::bindingIdentifiersToJs(const std::string &
                 -> b -> c
       [[this, [y, a, [b, c] ] ], ...]
 */
-std::vector<PropertyBindingContainer::Node *> PropertyBindingContainer::bindingIdentifiers(const std::string& source) const{
-    std::vector<PropertyBindingContainer::Node*> result;
+void PropertyBindingContainer::compile(const std::string& source, StringInterner &strings) const{
+    if ( m_isCompiled )
+        return;
+
+    m_nodes.clear();
+    m_roots.clear();
+    m_edges.clear();
 
     for (auto idx = m_bindings.begin(); idx != m_bindings.end(); ++idx){
         BaseNode* node = *idx;
@@ -102,7 +151,7 @@ std::vector<PropertyBindingContainer::Node *> PropertyBindingContainer::bindingI
             auto identifierChain = men->identifierChain(source);
 
             if ( identifierChain.size() > 1 ){
-                std::string startPoint = identifierChain.front();
+                std::string_view startPoint = identifierChain.front();
 
                 bool isDeclaredInScope = m_declarationCheck && m_declarationCheck(source, startPoint, node);
                 if ( isDeclaredInScope )
@@ -111,103 +160,105 @@ std::vector<PropertyBindingContainer::Node *> PropertyBindingContainer::bindingI
                 if ( isImport )
                     continue;
 
-                PropertyBindingContainer::Node* foundNode = nullptr;
-                for ( auto fit = result.begin(); fit != result.end(); ++fit ){
-                    if ( (*fit)->name == startPoint ){
-                        foundNode = *fit;
-                        break;
-                    }
-                }
-
-                if ( !foundNode ){
-                    PropertyBindingContainer::Node* node = new PropertyBindingContainer::Node;
-                    node->name = startPoint;
-                    result.push_back(node);
-                    for ( size_t i = 1; i < identifierChain.size(); ++i ){
-                        PropertyBindingContainer::Node* newNode = new PropertyBindingContainer::Node;
-                        newNode->name = identifierChain[i];
-                        node->next.push_back(newNode);
-                        node = newNode;
-                    }
-                } else {
-                    PropertyBindingContainer::Node* node = foundNode;
-                    for ( size_t i = 1; i < identifierChain.size(); ++i ){
-                        PropertyBindingContainer::Node* nextNode = node->findNextIdentifier(identifierChain[i]);
-                        if ( !nextNode ){
-                            for ( size_t j = i; j < identifierChain.size(); ++j ){
-                                PropertyBindingContainer::Node* newNode = new PropertyBindingContainer::Node;
-                                newNode->name = identifierChain[j];
-                                node->next.push_back(newNode);
-                                node = newNode;
-                            }
-                            break;
-                        } else {
-                            node = nextNode;
-                        }
-                    }
+                size_t current = NoParent;
+                for ( size_t i = 0; i < identifierChain.size(); ++i ){
+                    current = child(current, strings.intern(identifierChain[i]));
                 }
             }
         }
     }
-    return result;
+
+    std::string js;
+    if ( !m_roots.empty() ){
+        js = "[";
+        for ( auto it = m_roots.begin(); it != m_roots.end(); ++it ){
+            if ( it != m_roots.begin() )
+                js += ",";
+            bindingIdentifierToJs(*it, js);
+        }
+        js += "]";
+    }
+
+    m_js = strings.intern(js);
+    m_isCompiled = true;
 }
 
-std::string PropertyBindingContainer::bindingIdentifierToString(PropertyBindingContainer::Node *n) const{
-    std::string result;
-    if ( n->next.size() > 0 ){
-        result = "[" + n->name;
+/**
+ * \brief Returns the index of the child of \p parent called \p name, adding it if missing
+ */
+size_t PropertyBindingContainer::child(size_t parent, StringInterner::Id name) const{
+    auto edge = std::make_pair(parent, name);
+    auto it = m_edges.find(edge);
+    if ( it != m_edges.end() )
+        return it->second;
+
+    size_t index = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes.back().name = name;
+    m_nodes.back().parent = parent;
+    if ( parent == NoParent ){
+        m_roots.push_back(index);
+    } else {
+        m_nodes[parent].next.push_back(index);
+    }
+    m_edges.insert(std::make_pair(edge, index));
+    return index;
+}
 
-        for ( auto it = n->next.begin(); it != n->next.end(); ++it ){
-            result += "," + bindingIdentifierToString(*it);
+void PropertyBindingContainer::bindingIdentifierToString(size_t index, std::string& result) const{
+    const Node& n = m_nodes[index];
+    if ( n.next.size() > 0 ){
+        result += "[";
+        result += n.name.str();
+        for ( size_t next : n.next ){
+            result += ",";
+            bindingIdentifierToString(next, result);
         }
-
         result += "]";
     } else {
-        result += n->name;
+        result += n.name.str();
     }
-    return result;
 }
 
-std::string PropertyBindingContainer::bindingIdentifierToJs(PropertyBindingContainer::Node *n) const{
-    std::string result;
-    if ( n->next.size() > 0 ){
-        result = "[" + n->name;
-
-        for ( auto it = n->next.begin(); it != n->next.end(); ++it ){
-            result += "," + bindingIdentifierPropertyToJs(*it);
+void PropertyBindingContainer::bindingIdentifierToJs(size_t index, std::string& result) const{
+    const Node& n = m_nodes[index];
+    if ( n.next.size() > 0 ){
+        result += "[";
+        result += n.name.str();
+        for ( size_t next : n.next ){
+            result += ",";
+            bindingIdentifierPropertyToJs(next, result);
         }
-
         result += "]";
     } else {
-        result += n->name;
+        result += n.name.str();
     }
-    return result;
 }
 
-std::string PropertyBindingContainer::bindingIdentifierPropertyToJs(PropertyBindingContainer::Node *n) const{
-    std::string result;
-    if ( n->next.size() > 0 ){
-        result = "[";
-        if ( n->event.length() > 0 ){
-            result += "{n: '" + n->name + "',e: '" + n->event + "'}";
-        } else {
-            result += "'" + n->name + "'";
-        }
+void PropertyBindingContainer::bindingIdentifierPropertyToJs(size_t index, std::string& result) const{
+    const Node& n = m_nodes[index];
+    if ( n.next.size() > 0 )
+        result += "[";
+
+    if ( !n.event.empty() ){
+        result += "{n: '";
+        result += n.name.str();
+        result += "',e: '";
+        result += n.event.str();
+        result += "'}";
+    } else {
+        result += "'";
+        result += n.name.str();
+        result += "'";
+    }
 
-        for ( auto it = n->next.begin(); it != n->next.end(); ++it ){
-            result += "," + bindingIdentifierPropertyToJs(*it);
+    if ( n.next.size() > 0 ){
+        for ( size_t next : n.next ){
+            result += ",";
+            bindingIdentifierPropertyToJs(next, result);
         }
-
         result += "]";
-    } else {
-        if ( n->event.length() > 0 ){
-            result = "{n: '" + n->name + "',e: '" + n->event + "'}";
-        } else {
-            result = "'" + n->name + "'";
-        }
     }
-    return result;
 }
 
-
 }} // namespace lv, el
@@ -3,26 +3,38 @@
 
 #include <vector>
 #include <functional>
+#include <string_view>
+#include <unordered_map>
 #include "live/utf8.h"
+#include "stringinterner_p.h"
 
 namespace lv{ namespace el{
 
 class BaseNode;
 
+/**
+ * \class PropertyBindingContainer
+ * \brief Collects the member expressions a property binding depends on
+ *
+ * The dependencies are compiled once into a trie of interned names, stored in a flat array
+ * where each node keeps the indexes of its children. The serialized form is cached and
+ * interned, so properties with equal dependency sets share the same string. The compiled trie
+ * is kept until a binding is added or invalidate() is called, which the owner does when the
+ * source or the strings it was compiled against change.
+ */
 class PropertyBindingContainer{
 
 public:
+    static const size_t NoParent = static_cast<size_t>(-1);
+
     class Node{
     public:
-        Node() : parent(nullptr){}
-
-        ~Node();
-        Node* findNextIdentifier(const std::string& name) const;
+        Node() : parent(NoParent){}
 
-        std::string name;
-        std::string event;
-        Node*       parent;
-        std::vector<Node*> next;
+        StringInterner::Id  name;
+        StringInterner::Id  event;
+        size_t              parent;
+        std::vector<size_t> next;
     };
 
 public:
@@ -32,19 +44,42 @@ public:
     void addBinding(BaseNode* binding);
     size_t totalStoredBindings() const;
 
-    void setDeclarationCheck(std::function<bool (const std::string &, const std::string &, BaseNode *)> fn);
+    void setDeclarationCheck(std::function<bool (const std::string &, std::string_view, BaseNode *)> fn);
+    void invalidate();
+
+    std::string bindingIdentifiersToString(const std::string& source, StringInterner& strings) const;
+    const std::string& bindingIdentifiersToJs(const std::string& source, StringInterner& strings) const;
+    bool hasOnlyConstantDependencies(const std::string& source, StringInterner& strings) const;
 
-    std::string bindingIdentifiersToString(const std::string& source) const;
-    std::string bindingIdentifiersToJs(const std::string& source) const;
+    static bool isFrozenGlobal(std::string_view name);
+    static bool isConstantGlobalMember(std::string_view name, std::string_view member);
+
+    const std::vector<Node>& nodes() const{ return m_nodes; }
+    const std::vector<size_t>& roots() const{ return m_roots; }
 
 private:
-    std::vector<Node*> bindingIdentifiers(const std::string& source) const;
-    std::string bindingIdentifierToString(Node* n) const;
-    std::string bindingIdentifierToJs(Node* n) const;
-    std::string bindingIdentifierPropertyToJs(Node* n) const;
+    class EdgeHash{
+    public:
+        size_t operator()(const std::pair<size_t, StringInterner::Id>& edge) const{
+            return StringInterner::Id::Hash()(edge.second) ^ (edge.first * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    void compile(const std::string& source, StringInterner& strings) const;
+    size_t child(size_t parent, StringInterner::Id name) const;
 
-    std::function<bool(const std::string&, const std::string&, BaseNode*)> m_declarationCheck;
+    void bindingIdentifierToString(size_t index, std::string& result) const;
+    void bindingIdentifierToJs(size_t index, std::string& result) const;
+    void bindingIdentifierPropertyToJs(size_t index, std::string& result) const;
+
+    std::function<bool(const std::string&, std::string_view, BaseNode*)> m_declarationCheck;
     std::vector<BaseNode*> m_bindings;
+
+    mutable std::vector<Node>   m_nodes;
+    mutable std::vector<size_t> m_roots;
+    mutable std::unordered_map<std::pair<size_t, StringInterner::Id>, size_t, EdgeHash> m_edges;
+    mutable StringInterner::Id  m_js;
+    mutable bool                m_isCompiled;
 };
 
 inline size_t PropertyBindingContainer::totalStoredBindings() const{
@@ -0,0 +1,46 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "stringinterner_p.h"
+
+namespace lv{ namespace el{
+
+/**
+ * \brief Returns the handle for \p value, copying it into the interner on first use
+ *
+ * The empty string always maps to the default \c Id.
+ */
+StringInterner::Id StringInterner::intern(std::string_view value){
+    if ( value.empty() )
+        return Id();
+
+    auto it = m_index.find(value);
+    if ( it != m_index.end() )
+        return Id(it->second);
+
+    m_strings.emplace_back(value);
+    const std::string* stored = &m_strings.back();
+    m_index.insert(std::make_pair(std::string_view(*stored), stored));
+    m_totalBytes += value.size();
+    return Id(stored);
+}
+
+const std::string &StringInterner::emptyString(){
+    static const std::string empty;
+    return empty;
+}
+
+}} // namespace lv, el
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVSTRINGINTERNER_H
+#define LVSTRINGINTERNER_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+namespace lv{ namespace el{
+
+/**
+ * \class StringInterner
+ * \brief Stores a single copy of each identifier, type name and namespace used in a program tree.
+ *
+ * Interned strings are handed out as \c Id handles that stay valid for the lifetime of the
+ * interner. Equal strings interned in the same interner share the same handle, so they compare
+ * in constant time.
+ */
+class StringInterner{
+
+public:
+    typedef std::shared_ptr<StringInterner> Ptr;
+
+    /** \brief Handle to an interned string. The default handle is the empty string. */
+    class Id{
+
+    public:
+        Id() : m_value(&emptyString()){}
+
+        const std::string& str() const{ return *m_value; }
+        std::string_view view() const{ return *m_value; }
+        bool empty() const{ return m_value->empty(); }
+
+        bool operator == (const Id& other) const{ return m_value == other.m_value; }
+        bool operator != (const Id& other) const{ return m_value != other.m_value; }
+        bool operator < (const Id& other) const{ return m_value != other.m_value && *m_value < *other.m_value; }
+
+        /** \brief Hashes the handle itself, so it's only consistent within the same interner */
+        class Hash{
+        public:
+            size_t operator()(const Id& id) const{ return std::hash<const std::string*>()(id.m_value); }
+        };
+
+    private:
+        friend class StringInterner;
+        explicit Id(const std::string* value) : m_value(value){}
+
+        const std::string* m_value;
+    };
+
+public:
+    static Ptr create(){ return Ptr(new StringInterner); }
+
+    Id intern(std::string_view value);
+
+    size_t totalStrings() const{ return m_strings.size(); }
+    size_t totalBytes() const{ return m_totalBytes; }
+
+private:
+    StringInterner() : m_totalBytes(0){}
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator = (const StringInterner&) = delete;
+
+    static const std::string& emptyString();
+
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, const std::string*> m_index;
+    size_t m_totalBytes;
+};
+
+}} // namespace lv, el
+
+#endif // LVSTRINGINTERNER_H
@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace{
+
+std::atomic<size_t> allocationCount(0);
+
+} // namespace
+
+size_t AllocationCounter::totalAllocations(){
+    return allocationCount.load();
+}
+
+void* operator new(size_t size){
+    ++allocationCount;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if ( !p )
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size){
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept{
+    std::free(p);
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVALLOCATIONCOUNTER_H
+#define LVALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * \brief Counts calls to the global operator new made by the benchmark process
+ */
+class AllocationCounter{
+
+public:
+    static size_t totalAllocations();
+};
+
+#endif // LVALLOCATIONCOUNTER_H
@@ -0,0 +1,183 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "benchcorpus.h"
+
+std::string BenchCorpus::componentsSource(size_t components, size_t propertiesPerComponent){
+    std::string result;
+    for ( size_t c = 0; c < components; ++c ){
+        std::string name = "Component" + std::to_string(c);
+        result += "component " + name + " < Element{\n";
+        result += "    event changed(value:int)\n\n";
+        for ( size_t p = 0; p < propertiesPerComponent; ++p ){
+            std::string prop = "p" + std::to_string(p);
+            if ( p == 0 ){
+                result += "    int " + prop + ": " + std::to_string(c) + "\n";
+            } else {
+                result += "    int " + prop + ": this.p" + std::to_string(p - 1) + " + " + std::to_string(p) + "\n";
+            }
+        }
+        result += "\n    on changed: (value) => {\n";
+        result += "        var total = 0\n";
+        result += "        for ( var i = 0; i < value; ++i ){\n";
+        result += "            total += i * this.p0\n";
+        result += "        }\n";
+        result += "        this.p0 = total\n";
+        result += "    }\n\n";
+        result += "    fn compute(a:int, b:int){\n";
+        result += "        return a * b + this.p0\n";
+        result += "    }\n\n";
+        result += "    Element{\n";
+        result += "        int x: 20\n";
+        result += "        Element{ int y: 30 }\n";
+        result += "    }\n";
+        result += "}\n\n";
+    }
+    return result;
+}
+
+std::vector<BenchCorpus::File> BenchCorpus::componentFiles(size_t files, size_t componentsPerFile, size_t propertiesPerComponent){
+    std::vector<File> result;
+    std::string content = componentsSource(componentsPerFile, propertiesPerComponent);
+    for ( size_t i = 0; i < files; ++i ){
+        File f;
+        f.name = "File" + std::to_string(i) + ".lv";
+        f.content = content;
+        result.push_back(f);
+    }
+    return result;
+}
+
+/**
+ * \brief Components made of \p depth nested elements, each with a property and a binding to its parent
+ */
+std::string BenchCorpus::deepNestingSource(size_t components, size_t depth){
+    std::string result;
+    for ( size_t c = 0; c < components; ++c ){
+        result += "component Nested" + std::to_string(c) + " < Element{\n";
+        result += "    int level: 0\n";
+        std::string indent = "    ";
+        for ( size_t d = 0; d < depth; ++d ){
+            result += indent + "Element{\n";
+            indent += "    ";
+            result += indent + "id: level" + std::to_string(d) + "\n";
+            result += indent + "int level: " + (d == 0 ? std::string("parent.level") : "level" + std::to_string(d - 1) + ".level") + " + 1\n";
+        }
+        for ( size_t d = 0; d < depth; ++d ){
+            indent.resize(indent.size() - 4);
+            result += indent + "}\n";
+        }
+        result += "}\n\n";
+    }
+    return result;
+}
+
+/**
+ * \brief Components with \p properties properties, each bound to the two properties before it
+ */
+std::string BenchCorpus::bindingsSource(size_t components, size_t properties){
+    std::string result;
+    for ( size_t c = 0; c < components; ++c ){
+        result += "component Bindings" + std::to_string(c) + " < Element{\n";
+        for ( size_t p = 0; p < properties; ++p ){
+            std::string value;
+            if ( p < 2 ){
+                value = std::to_string(p);
+            } else {
+                value = "this.p" + std::to_string(p - 1) + " * this.p" + std::to_string(p - 2) + " + " + std::to_string(p);
+            }
+            result += "    int p" + std::to_string(p) + ": " + value + "\n";
+        }
+        result += "}\n\n";
+    }
+    return result;
+}
+
+/**
+ * \brief Components whose bindings are statement blocks declaring \p locals variables each, so
+ * every identifier in the block is looked up against the enclosing declarations
+ */
+std::string BenchCorpus::scopedBindingsSource(size_t components, size_t properties, size_t locals){
+    std::string result = "component Parent < Element{\n    int a: 1\n    int b: 2\n";
+    for ( size_t c = 0; c < components; ++c ){
+        result += "    Element{\n";
+        for ( size_t p = 0; p < properties; ++p ){
+            result += "        int p" + std::to_string(p) + ": {\n";
+            for ( size_t l = 0; l < locals; ++l ){
+                std::string previous = l == 0 ? std::string("parent.a") : "l" + std::to_string(l - 1);
+                result += "            var l" + std::to_string(l) + " = " + previous + " + parent.b\n";
+            }
+            std::string last = locals == 0 ? std::string("parent.b") : "l" + std::to_string(locals - 1);
+            result += "            return " + last + " + parent.a\n";
+            result += "        }\n";
+        }
+        result += "    }\n";
+    }
+    result += "}\n";
+    return result;
+}
+
+/**
+ * \brief A component whose functions hold \p statementsPerFunction lines of plain js each
+ */
+std::string BenchCorpus::largeJsSource(size_t functions, size_t statementsPerFunction){
+    std::string result = "component LargeJs < Element{\n";
+    for ( size_t f = 0; f < functions; ++f ){
+        result += "    fn compute" + std::to_string(f) + "(a:int, b:int){\n";
+        result += "        var total = a\n";
+        for ( size_t i = 0; i < statementsPerFunction; ++i ){
+            std::string n = std::to_string(i);
+            switch ( i % 4 ){
+            case 0: result += "        total = total * " + n + " + b\n"; break;
+            case 1: result += "        if ( total > " + n + " ){ total -= b } else { total += a }\n"; break;
+            case 2: result += "        for ( var i" + n + " = 0; i" + n + " < b; ++i" + n + " ){ total += i" + n + " }\n"; break;
+            default: result += "        var s" + n + " = [a, b, total].map(function(x){ return x + " + n + " })\n"; break;
+            }
+        }
+        result += "        return total\n";
+        result += "    }\n\n";
+    }
+    result += "}\n";
+    return result;
+}
+
+/**
+ * \brief A file importing \p imports modules, with an instance of \p usesPerImport types from each
+ */
+std::string BenchCorpus::wideImportsSource(size_t imports, size_t usesPerImport){
+    std::string result;
+    for ( size_t i = 0; i < imports; ++i ){
+        result += "import .module" + std::to_string(i) + " as m" + std::to_string(i) + "\n";
+    }
+    result += "\ncomponent WideImports < Element{\n";
+    for ( size_t i = 0; i < imports; ++i ){
+        for ( size_t u = 0; u < usesPerImport; ++u ){
+            result += "    m" + std::to_string(i) + ".Type" + std::to_string(u) + "{\n";
+            result += "        int value: " + std::to_string(u) + "\n";
+            result += "    }\n";
+        }
+    }
+    result += "}\n";
+    return result;
+}
+
+size_t BenchCorpus::lineCount(const std::string &source){
+    size_t lines = 0;
+    for ( char c : source )
+        if ( c == '\n' )
+            ++lines;
+    return lines;
+}
@@ -0,0 +1,48 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVBENCHCORPUS_H
+#define LVBENCHCORPUS_H
+
+#include <string>
+#include <vector>
+
+/**
+ * \brief Generates synthetic Elements sources for benchmarks
+ */
+class BenchCorpus{
+
+public:
+    class File{
+    public:
+        std::string name;
+        std::string content;
+    };
+
+public:
+    static std::string componentsSource(size_t components, size_t propertiesPerComponent);
+    static std::vector<File> componentFiles(size_t files, size_t componentsPerFile, size_t propertiesPerComponent);
+
+    static std::string deepNestingSource(size_t components, size_t depth);
+    static std::string bindingsSource(size_t components, size_t properties);
+    static std::string scopedBindingsSource(size_t components, size_t properties, size_t locals);
+    static std::string largeJsSource(size_t functions, size_t statementsPerFunction);
+    static std::string wideImportsSource(size_t imports, size_t usesPerImport);
+
+    static size_t lineCount(const std::string& source);
+};
+
+#endif // LVBENCHCORPUS_H
@@ -0,0 +1,49 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "live/applicationcontext.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+void parseThroughputBenchmark(std::ostream& out);
+void nodeTreeBenchmark(std::ostream& out);
+void phaseBenchmark(std::ostream& out, std::ostream& jsonOut);
+
+int main(int argc, char *argv[]){
+    lv::ApplicationContext::initialize({});
+
+    // the report goes to the standard error, so the standard output only carries the machine
+    // readable results, which --json <path> writes to a file instead
+    std::string jsonPath;
+    for ( int i = 1; i < argc - 1; ++i ){
+        if ( std::string(argv[i]) == "--json" )
+            jsonPath = argv[i + 1];
+    }
+
+    parseThroughputBenchmark(std::cerr);
+    nodeTreeBenchmark(std::cerr);
+
+    if ( jsonPath.empty() ){
+        phaseBenchmark(std::cerr, std::cout);
+    } else {
+        std::ofstream jsonOut(jsonPath);
+        phaseBenchmark(std::cerr, jsonOut);
+    }
+
+    return 0;
+}
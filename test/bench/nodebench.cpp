@@ -0,0 +1,192 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "benchcorpus.h"
+#include "allocationcounter.h"
+#include "live/fileio.h"
+#include "live/path.h"
+#include "live/elements/compiler/compiler.h"
+#include "live/elements/compiler/languageparser.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+const int nodeBenchRuns = 20;
+
+/**
+ * \brief Converts already parsed files, which covers building and releasing the node tree
+ */
+void convertCorpus(std::ostream& out, const std::string& corpusName, const std::vector<BenchCorpus::File>& files){
+    Compiler::Config compilerConfig(false);
+    compilerConfig.allowUnresolvedTypes(true);
+    Compiler::Ptr compiler = Compiler::create(compilerConfig);
+    compiler->configureImplicitType("console");
+    compiler->configureImplicitType("vlog");
+
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    std::vector<LanguageParser::AST*> asts;
+    size_t totalLines = 0;
+    for ( const auto& f : files ){
+        asts.push_back(parser->parse(f.content));
+        totalLines += BenchCorpus::lineCount(f.content);
+    }
+
+    size_t allocationsBefore = AllocationCounter::totalAllocations();
+    auto start = std::chrono::steady_clock::now();
+    for ( int run = 0; run < nodeBenchRuns; ++run ){
+        for ( size_t i = 0; i < files.size(); ++i ){
+            compiler->compileToJs(files[i].name, files[i].content, asts[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCounter::totalAllocations() - allocationsBefore;
+
+    for ( auto ast : asts ){
+        parser->destroy(ast);
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count() / nodeBenchRuns;
+    out << "  " << corpusName << " (" << files.size() << " files, " << totalLines << " lines)"
+        << ", time: " << ms << "ms"
+        << ", allocations: " << allocations / nodeBenchRuns << std::endl;
+}
+
+std::vector<BenchCorpus::File> unitTestFiles(){
+    FileIO fileIO;
+    std::vector<BenchCorpus::File> result;
+    for ( int i = 1; ; ++i ){
+        std::string name = std::string("ParserTest") + (i < 10 ? "0" : "") + std::to_string(i) + ".lv";
+        std::string path = Path::join(LV_ELEMENTS_COMPILER_BENCH_DATA, name);
+        if ( !Path::exists(path) )
+            break;
+
+        BenchCorpus::File f;
+        f.name = path;
+        f.content = fileIO.readFromFile(path);
+        result.push_back(f);
+    }
+    return result;
+}
+
+/**
+ * \brief Compares the size and conversion time of nested instances written as closures and as flat statements
+ */
+void instanceEmission(std::ostream& out, const std::string& corpusName, const std::vector<BenchCorpus::File>& files){
+    size_t totalLines = 0;
+    for ( const auto& f : files )
+        totalLines += BenchCorpus::lineCount(f.content);
+
+    out << "  " << corpusName << " (" << files.size() << " files, " << totalLines << " lines)";
+    size_t closureSize = 0;
+    for ( bool flatInstances : {false, true} ){
+        Compiler::Config compilerConfig(false);
+        compilerConfig.allowUnresolvedTypes(true);
+        compilerConfig.enableFlatInstances(flatInstances);
+        Compiler::Ptr compiler = Compiler::create(compilerConfig);
+        compiler->configureImplicitType("console");
+        compiler->configureImplicitType("vlog");
+
+        size_t totalSize = 0;
+        auto start = std::chrono::steady_clock::now();
+        for ( int run = 0; run < nodeBenchRuns; ++run ){
+            totalSize = 0;
+            for ( const auto& f : files )
+                totalSize += compiler->compileToJs(f.name, f.content).size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / nodeBenchRuns;
+        out << (flatInstances ? ", flat: " : ", closures: ") << totalSize << " bytes in " << ms << "ms";
+        if ( flatInstances && closureSize > 0 )
+            out << " (" << (100.0 * totalSize / closureSize) << "% of closures)";
+        else
+            closureSize = totalSize;
+    }
+    out << std::endl;
+}
+
+/**
+ * \brief Compares the size of the pretty and compact output, and how long the output takes to parse back
+ *
+ * The output is parsed with the elements parser, which stands in for the engine's js parser.
+ */
+void outputModes(std::ostream& out, const std::string& corpusName, const std::vector<BenchCorpus::File>& files){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    out << "  " << corpusName << " output";
+    for ( bool compactOutput : {false, true} ){
+        Compiler::Config compilerConfig(false);
+        compilerConfig.allowUnresolvedTypes(true);
+        compilerConfig.enableCompactOutput(compactOutput);
+        Compiler::Ptr compiler = Compiler::create(compilerConfig);
+        compiler->configureImplicitType("console");
+        compiler->configureImplicitType("vlog");
+
+        std::vector<std::string> outputs;
+        size_t totalSize = 0;
+        for ( const auto& f : files ){
+            outputs.push_back(compiler->compileToJs(f.name, f.content));
+            totalSize += outputs.back().size();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for ( int run = 0; run < nodeBenchRuns; ++run ){
+            for ( const std::string& js : outputs )
+                parser->destroy(parser->parse(js));
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / nodeBenchRuns;
+        out << (compactOutput ? ", compact: " : ", pretty: ") << totalSize << " bytes, parsed in " << ms << "ms";
+    }
+    out << std::endl;
+}
+
+} // namespace
+
+/**
+ * \brief Builds and releases node trees for the unit test sources and a synthetic 10k line file
+ *
+ * Times are per pass over the corpus and include conversion to js, allocations count every
+ * global operator new made during the pass. The unit test sources and the nested instances
+ * corpus are also converted with flat instances enabled, to report the difference in generated
+ * code size, and the unit test sources are converted in both pretty and compact mode.
+ */
+void nodeTreeBenchmark(std::ostream& out){
+    out << "node tree build and release (visit, convert, teardown)" << std::endl;
+
+    convertCorpus(out, "test/unit/data", unitTestFiles());
+    outputModes(out, "test/unit/data", unitTestFiles());
+    instanceEmission(out, "test/unit/data instances", unitTestFiles());
+
+    const size_t propertiesPerComponent = 20;
+    size_t linesPerComponent = BenchCorpus::lineCount(BenchCorpus::componentsSource(1, propertiesPerComponent));
+    BenchCorpus::File large;
+    large.name = "Large.lv";
+    large.content = BenchCorpus::componentsSource(10000 / linesPerComponent + 1, propertiesPerComponent);
+    convertCorpus(out, "synthetic", {large});
+
+    BenchCorpus::File nested;
+    nested.name = "Nested.lv";
+    nested.content = BenchCorpus::deepNestingSource(200, 8);
+    instanceEmission(out, "nested instances", {nested});
+}
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "benchcorpus.h"
+#include "live/elements/compiler/languageparser.h"
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+double parseCorpus(const LanguageParser::Ptr& parser, const std::vector<BenchCorpus::File>& files, size_t threadCount){
+    std::atomic<size_t> next(0);
+    auto parseWorker = [&parser, &files, &next](){
+        size_t index;
+        while ( (index = next++) < files.size() ){
+            LanguageParser::AST* ast = parser->parse(files[index].content);
+            parser->destroy(ast);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for ( size_t i = 0; i < threadCount; ++i ){
+        threads.push_back(std::thread(parseWorker));
+    }
+    for ( auto& t : threads ){
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+/**
+ * \brief Parses the same corpus from a single shared LanguageParser with an increasing number of threads
+ */
+void parseThroughputBenchmark(std::ostream& out){
+    std::vector<BenchCorpus::File> files = BenchCorpus::componentFiles(256, 20, 10);
+
+    size_t totalBytes = 0;
+    for ( const auto& f : files )
+        totalBytes += f.content.size();
+
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if ( maxThreads == 0 )
+        maxThreads = 1;
+
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+    parseCorpus(parser, files, 1); // warm up
+
+    double singleThreadMs = 0;
+    out << "parse throughput (" << files.size() << " files, " << totalBytes / 1024 << " KB)" << std::endl;
+    for ( size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2 ){
+        double ms = parseCorpus(parser, files, threadCount);
+        if ( threadCount == 1 )
+            singleThreadMs = ms;
+
+        double mbPerSecond = (totalBytes / (1024.0 * 1024.0)) / (ms / 1000.0);
+        out << "  threads: " << threadCount
+            << ", time: " << ms << "ms"
+            << ", throughput: " << mbPerSecond << "MB/s"
+            << ", speedup: " << singleThreadMs / ms << "x" << std::endl;
+    }
+    out << "  leased parsers: " << parser->totalLeasedParsers() << std::endl;
+}
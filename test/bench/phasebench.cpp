@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "benchcorpus.h"
+#include "allocationcounter.h"
+#include "languagenodes_p.h"
+#include "languagenodestojs_p.h"
+#include "elementssections_p.h"
+#include "live/fileio.h"
+#include "live/path.h"
+#include "live/elements/compiler/compiler.h"
+#include "live/elements/compiler/languageparser.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+const int phaseBenchRuns = 5;
+
+class PhaseTimes{
+public:
+    PhaseTimes() : parse(0), visit(0), collectImportTypes(0), convert(0), flatten(0), write(0), convertAllocations(0){}
+
+    double parse;
+    double visit;
+    double collectImportTypes;
+    double convert;
+    double flatten;
+    double write;
+    size_t convertAllocations;
+};
+
+class CorpusResult{
+public:
+    std::string kind;
+    std::string size;
+    size_t      bytes;
+    size_t      lines;
+    PhaseTimes  times;
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point& from){
+    auto now = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - from).count();
+    from = now;
+    return ms;
+}
+
+/**
+ * \brief Runs each phase of Compiler::compileToJs separately over \p source, times are averaged per run
+ */
+PhaseTimes timePhases(const Compiler::Ptr& compiler, const std::string& source, const std::string& outputPath){
+    PhaseTimes times;
+    FileIO fileIO;
+
+    BaseNode::ConversionContext ctx;
+    ctx.implicitTypes = {"console", "vlog"};
+
+    for ( int run = 0; run < phaseBenchRuns; ++run ){
+        auto current = std::chrono::steady_clock::now();
+
+        LanguageParser::AST* ast = compiler->parser()->parse(source);
+        times.parse += elapsedMs(current);
+
+        ProgramNode* root = compiler->parseProgramNodes("PhaseBench.lv", "PhaseBench", ast);
+        times.visit += elapsedMs(current);
+
+        size_t allocationsBefore = AllocationCounter::totalAllocations();
+
+        root->collectImportTypes(source, &ctx);
+        times.collectImportTypes += elapsedMs(current);
+
+        JSSection section(0, static_cast<int>(source.size()));
+        LanguageNodesToJs lnt;
+        lnt.convert(root, source, section.m_children, 0, &ctx);
+        times.convert += elapsedMs(current);
+
+        times.convertAllocations += AllocationCounter::totalAllocations() - allocationsBefore;
+
+        OutputBuffer output;
+        section.flatten(source, output);
+        std::string js = output.toString();
+        times.flatten += elapsedMs(current);
+
+        fileIO.writeToFile(outputPath, js);
+        times.write += elapsedMs(current);
+
+        for ( ElementsInsertion* ei : section.m_children )
+            delete ei;
+        delete root;
+        compiler->parser()->destroy(ast);
+    }
+
+    times.parse /= phaseBenchRuns;
+    times.visit /= phaseBenchRuns;
+    times.collectImportTypes /= phaseBenchRuns;
+    times.convert /= phaseBenchRuns;
+    times.flatten /= phaseBenchRuns;
+    times.write /= phaseBenchRuns;
+    times.convertAllocations /= phaseBenchRuns;
+    return times;
+}
+
+void writeJson(std::ostream& out, const std::vector<CorpusResult>& results){
+    out << "{\n  \"benchmark\": \"phases\",\n  \"runs\": " << phaseBenchRuns << ",\n  \"unit\": \"ms\",\n  \"corpora\": [\n";
+    for ( size_t i = 0; i < results.size(); ++i ){
+        const CorpusResult& r = results[i];
+        out << "    {\"kind\": \"" << r.kind << "\", \"size\": \"" << r.size << "\""
+            << ", \"bytes\": " << r.bytes << ", \"lines\": " << r.lines
+            << ", \"phases\": {"
+            << "\"parse\": " << r.times.parse
+            << ", \"visit\": " << r.times.visit
+            << ", \"collectImportTypes\": " << r.times.collectImportTypes
+            << ", \"convert\": " << r.times.convert
+            << ", \"flatten\": " << r.times.flatten
+            << ", \"write\": " << r.times.write
+            << "}, \"convertAllocations\": " << r.times.convertAllocations
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+/**
+ * \brief Times the compile phases separately over synthetic corpora of increasing size
+ *
+ * The corpora cover deep element nesting, many properties with bindings, large js blocks and
+ * wide import lists. A summary is printed to \p out, and the results are written as json to
+ * \p jsonOut.
+ */
+void phaseBenchmark(std::ostream& out, std::ostream& jsonOut){
+    Compiler::Config compilerConfig(false);
+    compilerConfig.allowUnresolvedTypes(true);
+    Compiler::Ptr compiler = Compiler::create(compilerConfig);
+
+    const char* sizeNames[] = {"small", "medium", "large"};
+    const size_t sizeScales[] = {1, 4, 16};
+
+    std::string outputPath = "lvelementscompilerbench.out.js";
+    std::vector<CorpusResult> results;
+
+    out << "compile phases (parse, visit, collect import types, convert, flatten, write)" << std::endl;
+    for ( size_t s = 0; s < 3; ++s ){
+        size_t scale = sizeScales[s];
+        std::vector<std::pair<std::string, std::string> > corpora = {
+            {"deepNesting", BenchCorpus::deepNestingSource(10 * scale, 24)},
+            {"bindings", BenchCorpus::bindingsSource(10 * scale, 60)},
+            {"scopedBindings", BenchCorpus::scopedBindingsSource(5 * scale, 40, 30)},
+            {"largeJs", BenchCorpus::largeJsSource(20 * scale, 100)},
+            {"wideImports", BenchCorpus::wideImportsSource(20 * scale, 10)}
+        };
+
+        for ( const auto& corpus : corpora ){
+            CorpusResult r;
+            r.kind  = corpus.first;
+            r.size  = sizeNames[s];
+            r.bytes = corpus.second.size();
+            r.lines = BenchCorpus::lineCount(corpus.second);
+            r.times = timePhases(compiler, corpus.second, outputPath);
+            results.push_back(r);
+
+            out << "  " << r.kind << " " << r.size << " (" << r.lines << " lines)"
+                << ", parse: " << r.times.parse << "ms"
+                << ", visit: " << r.times.visit << "ms"
+                << ", import types: " << r.times.collectImportTypes << "ms"
+                << ", convert: " << r.times.convert << "ms"
+                << ", flatten: " << r.times.flatten << "ms"
+                << ", write: " << r.times.write << "ms"
+                << ", allocations (import types + convert): " << r.times.convertAllocations << std::endl;
+        }
+    }
+
+    if ( Path::exists(outputPath) )
+        Path::remove(outputPath);
+
+    writeJson(jsonOut, results);
+}
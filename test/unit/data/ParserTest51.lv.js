@@ -0,0 +1,21 @@
+export class X extends Element{
+
+    constructor(){
+        super()
+        X.prototype.__initialize.call(this)
+    }
+    __initialize(){
+        Element.addProperty(this, 'a1', { type: 'int', notify: 'a1Changed'})
+        Element.addProperty(this, 'a2', { type: 'int', notify: 'a2Changed'})
+        Element.addProperty(this, 'a3', { type: 'int', notify: 'a3Changed'})
+        this.a1 = Math.PI
+        this.a2 = Math.PI * Number.EPSILON
+    Element.assignPropertyExpression(this,
+    'a3',
+    function(){ return this.a1 + Math.PI}.bind(this),
+    [[this,'a1'],[Math,'PI']]
+    )
+        this.b1 = Math.PI
+    }
+
+}
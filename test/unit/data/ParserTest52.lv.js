@@ -0,0 +1,22 @@
+export class X extends Element{
+
+    constructor(){
+        super()
+        X.prototype.__initialize.call(this)
+    }
+    __initialize(){
+        for ( let __p = 0; __p < X.__propertyDescriptors.length; ++__p )
+            Element.addProperty(this, X.__propertyDescriptors[__p][0], Object.assign({}, X.__propertyDescriptors[__p][1]))
+        for ( let __e = 0; __e < X.__eventDescriptors.length; ++__e )
+            Element.addEvent(this, X.__eventDescriptors[__e][0], X.__eventDescriptors[__e][1].slice())
+        this.a1 = 100
+    }
+
+}
+X.__propertyDescriptors = Object.freeze([
+    ['a1', Object.freeze({ type: 'int', notify: 'a1Changed'})],
+    ['a2', Object.freeze({ type: 'string', notify: 'a2Changed'})],
+])
+X.__eventDescriptors = Object.freeze([
+    ['changed', Object.freeze([['int','value']])],
+])
@@ -0,0 +1,75 @@
+import {Container} from '__UNRESOLVED__'
+
+export class FlatTest extends Container{
+    constructor(){
+        super()
+        FlatTest.prototype.__initialize.call(this)
+    }
+
+    __initialize(){
+        this.ids = {}
+
+        var e1 = new Element()
+        this.ids["e1"] = e1
+
+        var enested = new Element()
+        this.ids["enested"] = enested
+
+        var c1 = new Container()
+        this.ids["c1"] = c1
+
+        Element.addProperty(e1, 'x', {type: 'int', notify: 'xChanged'})
+        Element.addProperty(enested, 'y', {type: 'int', notify: 'yChanged'})
+
+        let __c0 = e1
+        {
+            let parent = this
+            __c0.setParent(parent)
+            Element.assignId(e1, "e1")
+            Element.assignPropertyExpression(
+                __c0,
+                'x',
+                function(){ return enested.y }.bind(__c0),
+                [[enested, 'y']]
+            )
+            Element.complete(__c0)
+        }
+        let __c1 = c1
+        {
+            let parent = this
+            __c1.setParent(parent)
+            Element.assignId(c1, "c1")
+            let __c2 = enested
+            {
+                let parent = __c1
+                __c2.setParent(parent)
+                Element.assignId(enested, "enested")
+                __c2.y = 200
+                Element.complete(__c2)
+            }
+            Element.assignChildrenAndComplete(__c1, [__c2])
+        }
+        Element.assignChildren(this, [__c0, __c1])
+    }
+}
+
+export class FlatFallbackTest extends Container{
+    constructor(){
+        super()
+        FlatFallbackTest.prototype.__initialize.call(this)
+    }
+
+    __initialize(){
+        Element.assignChildren(this, [
+            (function(parent){
+                this.setParent(parent)
+                Element.addProperty(this, 'a', {type: 'var', notify: 'aChanged'})
+                this.a = function(x){
+                    return x + 1
+                }.bind(this)
+                Element.complete(this)
+                return this
+            }.bind(new Element())(this))
+        ])
+    }
+}
@@ -0,0 +1,11 @@
+import {A as __0} from '__UNRESOLVED__'
+import {B as __1} from '__UNRESOLVED__'
+let mod={A:__0, B:__1}
+export class ParserTest54 extends mod.A{constructor(){super()
+ParserTest54.prototype.__initialize.call(this)}
+__initialize(){Element.addProperty(this,'b',{type:'string',notify:'bChanged'})
+Element.assignPropertyExpression(this,'b',function(){return mod.B.value}.bind(this),[[mod,['B','value']]])}
+format(value){var re=/^\s*x [/]/g
+var text=`value:
+    ${value.replace(re,'')}`
+return text+- -1}}
@@ -0,0 +1,29 @@
+export class Y extends Element{
+
+    constructor(){
+        super()
+        Y.prototype.__initialize.call(this)
+    }
+    __initialize(){
+        this.ids = {}
+
+        var Number = this
+        this.ids["Number"] = Number
+
+        Element.addProperty(this, 'EPSILON', { type: 'int', notify: 'EPSILONChanged'})
+        Element.addProperty(this, 'c1', { type: 'int', notify: 'c1Changed'})
+        Element.addProperty(this, 'c2', { type: 'int', notify: 'c2Changed'})
+        this.EPSILON = 1
+    Element.assignPropertyExpression(this,
+    'c1',
+    function(){ return Number.EPSILON}.bind(this),
+    [[Number,'EPSILON']]
+    )
+    Element.assignPropertyExpression(this,
+    'c2',
+    function(){ return Math.floor(1.5)}.bind(this),
+    [[Math,'floor']]
+    )
+    }
+
+}
@@ -0,0 +1,33 @@
+export class Y extends Element{
+
+    constructor(){
+        super()
+        Y.prototype.__initialize.call(this)
+    }
+    __initialize(){
+        this.ids = {}
+
+        var e1 = new Element()
+        this.ids["e1"] = e1
+
+        Element.addProperty(e1, 'y', { type: 'int', notify: 'yChanged'})
+        for ( let __p = 0; __p < Y.__propertyDescriptors.length; ++__p )
+            Element.addProperty(this, Y.__propertyDescriptors[__p][0], Object.assign({}, Y.__propertyDescriptors[__p][1]))
+        Element.addProperty(this, 'x', { type: 'int', notify: 'xChanged', get: function(){ return e1.y }, set: function(val){ e1.y = val }})
+        this.x = 10
+        this.count = 2
+        Element.assignChildren(this, [
+            (function(parent){
+                this.setParent(parent)
+                Element.assignId(e1, "e1")
+                this.y = 20
+                Element.complete(this)
+                return this
+            }.bind(e1)(this))
+        ])
+    }
+
+}
+Y.__propertyDescriptors = Object.freeze([
+    ['count', Object.freeze({ type: 'int', notify: 'countChanged'})],
+])
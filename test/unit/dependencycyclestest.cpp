@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+**
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "catch_library.h"
+
+#include "dependencycycles_p.h"
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+class CycleNode{
+public:
+    CycleNode(const std::string& n) : name(n){}
+
+    std::string           name;
+    std::list<CycleNode*> dependencies;
+};
+
+std::string findCycle(const std::vector<CycleNode*>& nodes){
+    std::list<CycleNode*> path = DependencyCycles<CycleNode>::find(nodes, [](CycleNode* node) -> const std::list<CycleNode*>&{
+        return node->dependencies;
+    });
+    return DependencyCycles<CycleNode>::toString(path, [](CycleNode* node){ return node->name; });
+}
+
+} // namespace
+
+TEST_CASE( "Dependency Cycles Test", "[Cycles]" ) {
+    CycleNode a("A"), b("B"), c("C"), d("D");
+
+    SECTION("No Cycle"){
+        a.dependencies = {&b, &c};
+        b.dependencies = {&c};
+        REQUIRE(findCycle({&a, &b, &c}) == "");
+    }
+    SECTION("Start At The Closing Edge"){
+        a.dependencies = {&b};
+        b.dependencies = {&a};
+        REQUIRE(findCycle({&a, &b}) == "B -> A -> B");
+        REQUIRE(findCycle({&b, &a}) == "A -> B -> A");
+    }
+    SECTION("Follow Edges In Order"){
+        a.dependencies = {&b};
+        b.dependencies = {&d, &c};
+        c.dependencies = {&a};
+        REQUIRE(findCycle({&a, &b, &c, &d}) == "C -> A -> B -> C");
+    }
+    SECTION("Report The First Closed Cycle"){
+        a.dependencies = {&b};
+        b.dependencies = {&a};
+        c.dependencies = {&d};
+        d.dependencies = {&c};
+        REQUIRE(findCycle({&c, &a, &b, &d}) == "B -> A -> B");
+    }
+    SECTION("Unlisted Nodes Added Their Edges First"){
+        a.dependencies = {&b};
+        b.dependencies = {&c};
+        c.dependencies = {&a};
+        REQUIRE(findCycle({&b}) == "B -> C -> A -> B");
+    }
+}
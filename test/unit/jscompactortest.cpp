@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+**
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "catch_library.h"
+
+#include "jscompactor_p.h"
+
+using namespace lv;
+using namespace lv::el;
+
+TEST_CASE( "Js Compactor Test", "[Compactor]" ) {
+    SECTION("Regex After Statement Head"){
+        REQUIRE(JsCompactor::compact("if (x) /a  b/.test(s)") == "if(x)/a  b/.test(s)");
+        REQUIRE(JsCompactor::compact("while ( i-- ) /a  b/g.exec(s)") == "while(i--)/a  b/g.exec(s)");
+        REQUIRE(JsCompactor::compact("for (;;) /a  b/.test(s)") == "for(;;)/a  b/.test(s)");
+    }
+    SECTION("Division After Parenthesis"){
+        REQUIRE(JsCompactor::compact("let x = (a + b) / 2") == "let x=(a+b)/2");
+        REQUIRE(JsCompactor::compact("if ( f(a) / 2 ) (b) / 2") == "if(f(a)/2)(b)/2");
+        REQUIRE(JsCompactor::compact("if (x) y = f(a) / 2 / b") == "if(x)y=f(a)/2/b");
+    }
+    SECTION("Regex After Keyword"){
+        REQUIRE(JsCompactor::compact("return /a  b/.test(s)") == "return/a  b/.test(s)");
+        REQUIRE(JsCompactor::compact("let x = a / b") == "let x=a/b");
+    }
+    SECTION("Template Substitutions"){
+        REQUIRE(JsCompactor::compact("let t = `a  ${ b  +  c } d ${ {x: 1}.x } e`") == "let t=`a  ${b+c} d ${{x:1}.x} e`");
+        REQUIRE(JsCompactor::compact("let t = `${ `in  ${ a }` }  out`") == "let t=`${`in  ${a}`}  out`");
+        REQUIRE(JsCompactor::compact("let t = `${ (a) / 2 }`") == "let t=`${(a)/2}`");
+    }
+    SECTION("Line Breaks Ending Statements"){
+        REQUIRE(JsCompactor::compact("let a = 1\nlet b = 2\n") == "let a=1\nlet b=2");
+        REQUIRE(JsCompactor::compact("x\n++y") == "x\n++y");
+        REQUIRE(JsCompactor::compact("return\nx") == "return\nx");
+        REQUIRE(JsCompactor::compact("foo(\n    a,\n    b\n)\nbar()") == "foo(a,b)\nbar()");
+    }
+    SECTION("Comments"){
+        REQUIRE(JsCompactor::compact("a /* c */ + b // d\nc") == "a+b\nc");
+        REQUIRE(JsCompactor::compact("a /* c\n */ b") == "a\nb");
+        REQUIRE(JsCompactor::compact("let s = '// not  a comment'") == "let s='// not  a comment'");
+    }
+}
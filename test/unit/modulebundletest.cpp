@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 Dinu SV.
+**
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "catch_library.h"
+#include "live/exception.h"
+
+#include "modulebundle_p.h"
+
+using namespace lv;
+using namespace lv::el;
+
+TEST_CASE( "Module Bundle Test", "[Bundle]" ) {
+    SECTION("Read Named Imports"){
+        std::string output = "import {A, B as __1} from './A.lv.js'\nlet x = 1\n";
+        ModuleBundle::Import import;
+        size_t position = ModuleBundle::readImport(output, 0, import);
+
+        REQUIRE(position == output.find("\nlet"));
+        REQUIRE(import.path == "./A.lv.js");
+        REQUIRE(import.names.size() == 2);
+        REQUIRE(import.names[0] == std::make_pair(std::string("A"), std::string("A")));
+        REQUIRE(import.names[1] == std::make_pair(std::string("B"), std::string("__1")));
+
+        ModuleBundle::Import next;
+        REQUIRE(ModuleBundle::readImport(output, position, next) == std::string::npos);
+    }
+    SECTION("Read Compacted Imports"){
+        std::string output = "import{A as __0}from'lib/A.js';import{B as __1}from\"lib/B.js\"\nlet mod={A:__0}";
+        ModuleBundle::Import first;
+        size_t position = ModuleBundle::readImport(output, 0, first);
+        REQUIRE(position != std::string::npos);
+        REQUIRE(first.path == "lib/A.js");
+        REQUIRE(first.names.size() == 1);
+        REQUIRE(first.names[0] == std::make_pair(std::string("A"), std::string("__0")));
+
+        ModuleBundle::Import second;
+        position = ModuleBundle::readImport(output, position, second);
+        REQUIRE(position == output.find("\nlet"));
+        REQUIRE(second.path == "lib/B.js");
+        REQUIRE(second.names[0] == std::make_pair(std::string("B"), std::string("__1")));
+    }
+    SECTION("Read Default Import"){
+        ModuleBundle::Import import;
+        REQUIRE(ModuleBundle::readImport("import A from 'a.js'", 0, import) != std::string::npos);
+        REQUIRE(import.names[0] == std::make_pair(std::string("default"), std::string("A")));
+    }
+    SECTION("Reject Other Statements"){
+        ModuleBundle::Import import;
+        REQUIRE(ModuleBundle::readImport("imports = 1", 0, import) == std::string::npos);
+        REQUIRE(ModuleBundle::readImport("import * as A from 'a.js'", 0, import) == std::string::npos);
+        REQUIRE(ModuleBundle::readImport("import {A} 'a.js'", 0, import) == std::string::npos);
+    }
+    SECTION("Remove Exports"){
+        std::string output =
+            "export class A extends B{}\n"
+            "export let a = new A()\n"
+            "export class C{}\n"
+            "let s = 'export class A'\n";
+        std::string result = ModuleBundle::removeExports(output, {"A", "a"});
+        REQUIRE(result ==
+            "class A extends B{}\n"
+            "let a = new A()\n"
+            "export class C{}\n"
+            "let s = 'export class A'\n"
+        );
+    }
+    SECTION("Remove Compacted Exports"){
+        std::string output = "export class A extends mod.B{constructor(){super()}}\nexport class Ab{}";
+        REQUIRE(ModuleBundle::removeExports(output, {"A"}) == "class A extends mod.B{constructor(){super()}}\nexport class Ab{}");
+    }
+    SECTION("Order Files By Imports"){
+        ModuleBundle::File b;
+        b.importPath = "./B.lv.js";
+        b.output = "import{A as __0}from'./A.lv.js'\nimport{Element as __1}from'lib/Element.js'\nexport class B extends __0{}";
+        b.exports = {"B"};
+
+        ModuleBundle::File a;
+        a.importPath = "./A.lv.js";
+        a.output = "import {Element} from 'lib/Element.js'\nexport class A extends Element{}";
+        a.exports = {"A"};
+
+        ModuleBundle bundle;
+        bundle.addFile(b);
+        bundle.addFile(a);
+        std::string result = bundle.toString();
+
+        REQUIRE(result.find("./A.lv.js") == std::string::npos);
+        REQUIRE(result.find("import {Element as __b0} from 'lib/Element.js'\n") == 0);
+        REQUIRE(result.find("class A extends Element") < result.find("class B extends __0"));
+        REQUIRE(result.find("const __0 = A\n") != std::string::npos);
+        REQUIRE(result.find("export {A, B}\n") != std::string::npos);
+    }
+    SECTION("Reject Import Cycles"){
+        ModuleBundle::File a;
+        a.importPath = "./A.lv.js";
+        a.output = "import {B} from './B.lv.js'\nexport class A{}";
+        a.exports = {"A"};
+
+        ModuleBundle::File b;
+        b.importPath = "./B.lv.js";
+        b.output = "import {A} from './A.lv.js'\nexport class B{}";
+        b.exports = {"B"};
+
+        ModuleBundle bundle;
+        bundle.addFile(a);
+        bundle.addFile(b);
+        REQUIRE_THROWS_AS(bundle.toString(), lv::Exception);
+    }
+}
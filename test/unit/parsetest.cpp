@@ -22,11 +22,20 @@
 
 #include "live/elements/compiler/languageparser.h"
 #include "live/elements/compiler/compiler.h"
+#include "live/elements/compiler/elementsmodule.h"
+#include "live/elements/compiler/modulefile.h"
+
+#include <functional>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
 
 using namespace lv;
 using namespace lv::el;
 
-void testFileParse(const std::string& name){
+void testFileParse(const std::string& name, const std::function<void(Compiler::Config&)>& configure = nullptr){
     static FileIO fileIO;
     static std::string scriptPath = Path::join(Path::parent(lv::ApplicationContext::instance().applicationFilePath()), "data");
 
@@ -45,6 +54,8 @@ void testFileParse(const std::string& name){
             Compiler::Config compilerConfig(false);
             compilerConfig.allowUnresolvedTypes(true);
             compilerConfig.outputTypes(expectation == ".ts");
+            if ( configure )
+                configure(compilerConfig);
             Compiler::Ptr compiler = Compiler::create(compilerConfig);
             compiler->configureImplicitType("console");
             compiler->configureImplicitType("vlog");
@@ -75,6 +86,169 @@ void testFileParse(const std::string& name){
     }
 }
 
+/**
+ * Instances built by converted output: the ids it declares, the order instances complete in,
+ * and the children assigned to each. Closure and flat instance output build the same structure.
+ */
+class InstanceStructure{
+public:
+    std::vector<std::string> ids;
+    std::vector<std::string> completed;
+    std::map<std::string, std::vector<std::string> > children;
+};
+
+InstanceStructure instanceStructure(const std::string& js){
+    class Frame{
+    public:
+        size_t instance;
+        bool   childrenOpen;
+        bool   completes;
+    };
+
+    // instances are named by the order they start in and the object they are bound to
+    std::vector<std::string> names = {"module"};
+    std::vector<size_t> completed;
+    std::map<size_t, std::vector<size_t> > children;
+    std::map<std::string, size_t> flatInstances;
+    std::vector<Frame> frames = {{0, false, false}};
+    InstanceStructure result;
+
+    auto startInstance = [&names](){
+        names.push_back(std::to_string(names.size()));
+        return names.size() - 1;
+    };
+
+    std::regex token(
+        "class (\\w+) extends"
+        "|\\(function\\(parent\\)\\{"
+        "|return this\\s*\\}\\.bind\\("
+        "|let (__c\\d+) = ([^\\n]*)"
+        "|Element\\.complete\\((this|__c\\d+)\\)"
+        "|Element\\.assignChildren(AndComplete)?\\((this|__c\\d+), \\[\\s*((?:__c\\d+(?:, )?)*)"
+        "|this\\.ids\\[\"(\\w+)\"\\]"
+    );
+    for ( auto it = std::sregex_iterator(js.begin(), js.end(), token); it != std::sregex_iterator(); ++it ){
+        const std::smatch& m = *it;
+        std::string match = m.str();
+        if ( m[1].matched ){
+            frames.resize(1);
+            frames.push_back({startInstance(), false, false});
+            names.back() += ":class " + m.str(1);
+        } else if ( match[0] == '(' ){
+            size_t instance = startInstance();
+            if ( frames.back().childrenOpen )
+                children[frames.back().instance].push_back(instance);
+            frames.push_back({instance, false, false});
+        } else if ( match.compare(0, 11, "return this") == 0 ){
+            // the bound object is the expression up to the matching parenthesis
+            size_t start = m.position() + m.length();
+            size_t end = start;
+            for ( int depth = 1; end < js.size(); ++end ){
+                depth += js[end] == '(' ? 1 : js[end] == ')' ? -1 : 0;
+                if ( depth == 0 )
+                    break;
+            }
+            Frame frame = frames.back();
+            names[frame.instance] += ":" + js.substr(start, end - start);
+            if ( frame.completes )
+                completed.push_back(frame.instance);
+            if ( frames.size() > 1 )
+                frames.pop_back();
+        } else if ( m[2].matched ){
+            size_t instance = startInstance();
+            names.back() += ":" + m.str(3);
+            flatInstances[m.str(2)] = instance;
+        } else if ( m[4].matched ){
+            if ( m.str(4) == "this" )
+                frames.back().completes = true;
+            else
+                completed.push_back(flatInstances[m.str(4)]);
+        } else if ( m[6].matched ){
+            bool isThis = m.str(6) == "this";
+            size_t owner = isThis ? frames.back().instance : flatInstances[m.str(6)];
+            if ( m.str(7).empty() ){
+                frames.back().childrenOpen = true;
+            } else {
+                std::stringstream list(m.str(7));
+                std::string child;
+                while ( std::getline(list, child, ',') ){
+                    child.erase(0, child.find_first_not_of(' '));
+                    children[owner].push_back(flatInstances[child]);
+                }
+            }
+            if ( m[5].matched ){
+                if ( isThis )
+                    frames.back().completes = true;
+                else
+                    completed.push_back(owner);
+            }
+        } else if ( m[8].matched ){
+            result.ids.push_back(m.str(8));
+        }
+    }
+
+    for ( size_t instance : completed )
+        result.completed.push_back(names[instance]);
+    for ( auto it = children.begin(); it != children.end(); ++it ){
+        std::vector<std::string>& assigned = result.children[names[it->first]];
+        for ( size_t child : it->second )
+            assigned.push_back(names[child]);
+    }
+    return result;
+}
+
+/**
+ * Compiles \p name with flat instances and compares it with its closure golden. Flat output
+ * differs in its syntax, so unless it matches, it has to parse and build the same instances.
+ */
+void testFlatInstances(const std::string& name){
+    static FileIO fileIO;
+    static std::string scriptPath = Path::join(Path::parent(lv::ApplicationContext::instance().applicationFilePath()), "data");
+
+    try{
+        std::string contents = fileIO.readFromFile(Path::join(scriptPath, name + ".lv"));
+        std::string expectedContent = fileIO.readFromFile(Path::join(scriptPath, name + ".lv.js"));
+
+        Compiler::Config compilerConfig(false);
+        compilerConfig.allowUnresolvedTypes(true);
+        compilerConfig.enableFlatInstances(true);
+        Compiler::Ptr compiler = Compiler::create(compilerConfig);
+        compiler->configureImplicitType("console");
+        compiler->configureImplicitType("vlog");
+
+        std::string conversion = compiler->compileToJs(Path::join(scriptPath, name + ".lv"), contents);
+
+        el::LanguageParser::Ptr parser = el::LanguageParser::createForElements();
+        el::LanguageParser::AST* conversionAST = parser->parse(conversion);
+        el::LanguageParser::AST* expectedAST   = parser->parse(expectedContent);
+
+        el::LanguageParser::ComparisonResult compare = parser->compare(expectedContent, expectedAST, conversion, conversionAST);
+        bool hasErrors = ts_node_has_error(ts_tree_root_node(reinterpret_cast<TSTree*>(conversionAST)));
+        parser->destroy(conversionAST);
+        parser->destroy(expectedAST);
+
+        if ( compare.isEqual() )
+            return;
+
+        if ( hasErrors ){
+            vlog().e() << "File: " << name << ".lv";
+            vlog().e() << conversion;
+        }
+        REQUIRE(!hasErrors);
+
+        InstanceStructure expected = instanceStructure(expectedContent);
+        InstanceStructure flat = instanceStructure(conversion);
+        REQUIRE(flat.ids == expected.ids);
+        REQUIRE(flat.completed == expected.completed);
+        REQUIRE(flat.children == expected.children);
+
+    } catch ( lv::el::SyntaxException& e ){
+        FAIL(Utf8("SyntaxException: % at %:%").format(e.message(), e.parsedLocation().filePath(), e.parsedLocation().range().start().line()).data().c_str());
+    } catch ( lv::Exception& e ){
+        FAIL(("Exception triggered: " + e.message()).c_str());
+    }
+}
+
 
 
 TEST_CASE( "Parse Test", "[Parse]" ) {
@@ -166,5 +340,200 @@ TEST_CASE( "Parse Test", "[Parse]" ) {
     SECTION("Anonymous Components"){ testFileParse("ParserTest49"); }
     SECTION("Additional Declarations"){ testFileParse("ParserTest50"); }
     SECTION("Function & Variables Type Test"){ testFileParse("ParserTypeTest01"); }
+    SECTION("Static Bindings"){ testFileParse("ParserTest51", [](Compiler::Config& c){ c.enableStaticBindings(true); }); }
+    SECTION("Static Bindings Shadowed Global"){ testFileParse("ParserTest55", [](Compiler::Config& c){ c.enableStaticBindings(true); }); }
+    SECTION("Static Descriptors"){ testFileParse("ParserTest52", [](Compiler::Config& c){ c.enableStaticDescriptors(true); }); }
+    SECTION("Static Descriptors With Accessors"){ testFileParse("ParserTest56", [](Compiler::Config& c){ c.enableStaticDescriptors(true); }); }
+    SECTION("Flat Instances"){ testFileParse("ParserTest53", [](Compiler::Config& c){ c.enableFlatInstances(true); }); }
+    SECTION("Compact Output"){ testFileParse("ParserTest54", [](Compiler::Config& c){ c.enableCompactOutput(true); }); }
+    SECTION("Flat Instances Match Closures"){
+        testFlatInstances("ParserTest05");
+        testFlatInstances("ParserTest09");
+        testFlatInstances("ParserTest23");
+        testFlatInstances("ParserTest44");
+    }
+}
+
+
+TSPoint sourcePoint(const std::string& source, uint32_t byte){
+    TSPoint point = {0, 0};
+    for ( uint32_t i = 0; i < byte; ++i ){
+        if ( source[i] == '\n' ){
+            ++point.row;
+            point.column = 0;
+        } else {
+            ++point.column;
+        }
+    }
+    return point;
 }
 
+TEST_CASE( "Incremental Parse Test", "[Parse]" ) {
+    SECTION("Reparse Insertion"){
+        static FileIO fileIO;
+        static std::string scriptPath = Path::join(Path::parent(lv::ApplicationContext::instance().applicationFilePath()), "data");
+
+        std::string contents = fileIO.readFromFile(Path::join(scriptPath, "ParserTest01.lv"));
+        std::string insertion = "    int c3 : 400\n";
+        uint32_t position = static_cast<uint32_t>(contents.rfind("}"));
+
+        std::string editedContents = contents;
+        editedContents.insert(position, insertion);
+
+        TSInputEdit edit;
+        edit.start_byte    = position;
+        edit.old_end_byte  = position;
+        edit.new_end_byte  = position + static_cast<uint32_t>(insertion.size());
+        edit.start_point   = sourcePoint(contents, position);
+        edit.old_end_point = edit.start_point;
+        edit.new_end_point = sourcePoint(editedContents, edit.new_end_byte);
+
+        el::LanguageParser::Ptr parser = el::LanguageParser::createForElements();
+        el::LanguageParser::AST* ast = parser->parse(contents);
+        el::LanguageParser::AST* reparsedAST = parser->reparse(ast, editedContents, {edit});
+        el::LanguageParser::AST* expectedAST = parser->parse(editedContents);
+
+        el::LanguageParser::ComparisonResult compare = parser->compare(editedContents, expectedAST, editedContents, reparsedAST);
+        parser->destroy(ast);
+        parser->destroy(reparsedAST);
+        parser->destroy(expectedAST);
+
+        REQUIRE(compare.isEqual());
+    }
+}
+
+/**
+ * A module directory under the system temporary path, removed with its contents on destruction
+ */
+class TemporaryModuleDirectory{
+public:
+    TemporaryModuleDirectory(const std::string& moduleName){
+        std::string unique = "lvelementscompilertest-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        m_root = (std::filesystem::temp_directory_path() / unique).string();
+        m_path = Path::join(m_root, moduleName);
+        Path::createDirectories(m_path);
+    }
+    ~TemporaryModuleDirectory(){
+        std::error_code ec;
+        std::filesystem::remove_all(m_root, ec);
+    }
+
+    const std::string& path() const{ return m_path; }
+
+private:
+    std::string m_root;
+    std::string m_path;
+};
+
+std::string compileEditTestModule(const std::string& modulePath, const std::string& fileName, const std::string& cachePath, const std::string& editedContents = "", const std::vector<TSInputEdit>& edits = {}){
+    Compiler::Config compilerConfig;
+    compilerConfig.allowUnresolvedTypes(true);
+    compilerConfig.enableFlatInstances(true);
+    compilerConfig.setCompileCachePath(cachePath);
+    Compiler::Ptr compiler = Compiler::create(compilerConfig);
+
+    ElementsModule::Ptr epl = Compiler::compile(compiler, Path::join(modulePath, fileName));
+    ModuleFile* mf = epl->findModuleFileByName(fileName);
+    if ( !edits.empty() ){
+        mf->edit(editedContents, edits);
+        mf->compile();
+    }
+    return compiler->fileIO()->readFromFile(compiler->moduleFileBuildPath(epl->module(), mf->filePath()));
+}
+
+TSInputEdit replacementEdit(const std::string& contents, uint32_t position, uint32_t removed, const std::string& inserted){
+    std::string editedContents = contents;
+    editedContents.replace(position, removed, inserted);
+
+    TSInputEdit edit;
+    edit.start_byte    = position;
+    edit.old_end_byte  = position + removed;
+    edit.new_end_byte  = position + static_cast<uint32_t>(inserted.size());
+    edit.start_point   = sourcePoint(contents, position);
+    edit.old_end_point = sourcePoint(contents, edit.old_end_byte);
+    edit.new_end_point = sourcePoint(editedContents, edit.new_end_byte);
+    return edit;
+}
+
+void requireEditMatchesFullCompile(const std::string& contents, uint32_t position, uint32_t removed, const std::string& inserted){
+    static FileIO fileIO;
+    TemporaryModuleDirectory directory("ModuleEditTest");
+    std::string fileName = "ModuleEditTest.lv";
+    std::string filePath = Path::join(directory.path(), fileName);
+
+    std::string editedContents = contents;
+    editedContents.replace(position, removed, inserted);
+    TSInputEdit edit = replacementEdit(contents, position, removed, inserted);
+
+    try{
+        fileIO.writeToFile(filePath, contents);
+        std::string editOutput = compileEditTestModule(directory.path(), fileName, Path::join(directory.path(), "editcache"), editedContents, {edit});
+
+        fileIO.writeToFile(filePath, editedContents);
+        std::string fullOutput = compileEditTestModule(directory.path(), fileName, Path::join(directory.path(), "fullcache"));
+
+        if ( editOutput != fullOutput ){
+            vlog().e() << "Edited output: " << editOutput;
+            vlog().e() << "Full compile output: " << fullOutput;
+        }
+        REQUIRE(editOutput == fullOutput);
+    } catch ( lv::Exception& e ){
+        FAIL(("Exception triggered: " + e.message()).c_str());
+    }
+}
+
+TEST_CASE( "Module File Edit Test", "[Parse]" ) {
+    std::string contents =
+        "component EditFirst < Container{\n"
+        "    Element{\n"
+        "        int x: 100\n"
+        "    }\n"
+        "}\n"
+        "\n"
+        "component EditSecond < Container{\n"
+        "    Element{\n"
+        "        int y: 200\n"
+        "    }\n"
+        "}\n";
+
+    SECTION("Edit Matches Full Compile"){
+        // a child added to the first component shifts the flat instance names of the second one
+        std::string insertion = "    Element{\n        int z: 300\n    }\n";
+        uint32_t position = static_cast<uint32_t>(contents.find("}\n\ncomponent EditSecond"));
+        requireEditMatchesFullCompile(contents, position, 0, insertion);
+    }
+    SECTION("Edit Before Reused Export"){
+        // the second component keeps its output, shifted by the longer value
+        uint32_t position = static_cast<uint32_t>(contents.find("100"));
+        requireEditMatchesFullCompile(contents, position, 3, "100000");
+    }
+    SECTION("Edit Updates Module Exports"){
+        static FileIO fileIO;
+        TemporaryModuleDirectory directory("ModuleEditTest");
+        std::string fileName = "ModuleEditTest.lv";
+        std::string filePath = Path::join(directory.path(), fileName);
+
+        try{
+            fileIO.writeToFile(filePath, contents);
+
+            Compiler::Config compilerConfig;
+            compilerConfig.allowUnresolvedTypes(true);
+            compilerConfig.setCompileCachePath(Path::join(directory.path(), "cache"));
+            Compiler::Ptr compiler = Compiler::create(compilerConfig);
+
+            ElementsModule::Ptr epl = Compiler::compile(compiler, filePath);
+            ModuleFile* mf = epl->findModuleFileByName(fileName);
+            REQUIRE(epl->findExport("EditSecond").isValid());
+
+            uint32_t position = static_cast<uint32_t>(contents.find("EditSecond"));
+            std::string editedContents = contents;
+            editedContents.replace(position, 10, "EditRenamed");
+            mf->edit(editedContents, {replacementEdit(contents, position, 10, "EditRenamed")});
+
+            REQUIRE(!epl->findExport("EditSecond").isValid());
+            REQUIRE(epl->findExport("EditRenamed").file == mf);
+        } catch ( lv::Exception& e ){
+            FAIL(("Exception triggered: " + e.message()).c_str());
+        }
+    }
+}